@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "allocation-counter.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<std::size_t> allocations{ 0 };
+    std::atomic<std::size_t> live_bytes{ 0 };
+    std::atomic<std::size_t> live_blocks{ 0 };
+    std::atomic<std::size_t> peak_bytes{ 0 };
+
+    // Each allocation is prefixed with its size, padded to keep the default alignment.
+    constexpr std::size_t header_size = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    void count_allocation(std::size_t size) noexcept
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        const auto bytes = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+        live_blocks.fetch_add(1, std::memory_order_relaxed);
+
+        auto peak = peak_bytes.load(std::memory_order_relaxed);
+        while (bytes > peak && !peak_bytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void count_release(const std::byte* block) noexcept
+    {
+        live_bytes.fetch_sub(*reinterpret_cast<const std::size_t*>(block), std::memory_order_relaxed);
+        live_blocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Over-aligned allocations are prefixed with a whole alignment unit instead.
+    auto aligned_header_size(std::align_val_t alignment) noexcept -> std::size_t
+    {
+        return std::max(header_size, static_cast<std::size_t>(alignment));
+    }
+}
+
+auto operator new(std::size_t size) -> void*
+{
+    count_allocation(size);
+    if (auto* block = static_cast<std::byte*>(std::malloc(header_size + size)); block)
+    {
+        *reinterpret_cast<std::size_t*>(block) = size;
+        return block + header_size;
+    }
+
+    throw std::bad_alloc();
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void*
+{
+    count_allocation(size);
+    const auto header = aligned_header_size(alignment);
+    if (auto* block = static_cast<std::byte*>(std::aligned_alloc(header, (header + size + header - 1) / header * header)); block)
+    {
+        *reinterpret_cast<std::size_t*>(block) = size;
+        return block + header;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer)
+    {
+        auto* block = static_cast<std::byte*>(pointer) - header_size;
+        count_release(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+    if (pointer)
+    {
+        auto* block = static_cast<std::byte*>(pointer) - aligned_header_size(alignment);
+        count_release(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+namespace linguist::bench
+{
+    auto allocation_count() noexcept -> std::size_t
+    {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+    auto allocated_bytes() noexcept -> std::size_t
+    {
+        return live_bytes.load(std::memory_order_relaxed);
+    }
+
+    auto allocated_blocks() noexcept -> std::size_t
+    {
+        return live_blocks.load(std::memory_order_relaxed);
+    }
+
+    auto peak_allocated_bytes() noexcept -> std::size_t
+    {
+        return peak_bytes.load(std::memory_order_relaxed);
+    }
+
+    void reset_peak_allocated_bytes() noexcept
+    {
+        peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+} // namespace linguist::bench
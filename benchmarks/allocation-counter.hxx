@@ -0,0 +1,34 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+
+namespace linguist::bench
+{
+    /// Get the number of heap allocations made by the process so far
+    ///
+    /// \return Count of calls to the global operator new
+    [[nodiscard]] auto allocation_count() noexcept -> std::size_t;
+
+    /// Get the number of heap bytes currently allocated by the process
+    ///
+    /// \return Bytes requested from the global operator new and not yet released
+    [[nodiscard]] auto allocated_bytes() noexcept -> std::size_t;
+
+    /// Get the number of heap blocks currently allocated by the process
+    ///
+    /// \return Allocations made by the global operator new and not yet released
+    [[nodiscard]] auto allocated_blocks() noexcept -> std::size_t;
+
+    /// Get the highest number of heap bytes allocated at once since the last reset
+    ///
+    /// \return Peak of allocated_bytes()
+    [[nodiscard]] auto peak_allocated_bytes() noexcept -> std::size_t;
+
+    /// Restart peak tracking from the bytes currently allocated
+    void reset_peak_allocated_bytes() noexcept;
+
+} // namespace linguist::bench
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/translator.hxx>
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    // Large enough that the index and translations do not stay in cache between lookups.
+    constexpr std::size_t k_key_count = 50000;
+
+    // Locales of the synthetic catalog.
+    constexpr const char* k_locales[] = { "en-US", "fr-FR", "de-DE", "es-ES" };
+
+    auto make_identifier(std::size_t key) -> std::string
+    {
+        return "screen" + std::to_string(key % 64) + ".widget" + std::to_string(key) + ".label";
+    }
+
+    /// Translator loaded with a synthetic catalog, shared by every batch size
+    auto shared_translator() -> const linguist::translator&
+    {
+        static const auto translator = []()
+        {
+            std::string json = "{";
+            for (std::size_t key = 0; key < k_key_count; ++key)
+            {
+                json += (key == 0 ? "\"" : ",\"") + make_identifier(key) + "\":{";
+                for (std::size_t locale = 0; locale < std::size(k_locales); ++locale)
+                {
+                    json += (locale == 0 ? "\"" : ",\"") + std::string(k_locales[locale]) + "\":\"Translated text for widget " +
+                        std::to_string(key) + " in " + k_locales[locale] + "\"";
+                }
+                json += "}";
+            }
+            json += "}";
+
+            linguist::translator translator;
+            if (!translator.load_from_string(json))
+            {
+                throw std::runtime_error("failed to load benchmark catalog");
+            }
+
+            translator.set_locale("fr-FR");
+            return translator;
+        }();
+
+        return translator;
+    }
+
+    /// Identifiers of one rendered screen, drawn uniformly from the catalog
+    auto make_screen(std::size_t size) -> std::vector<std::string>
+    {
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<std::size_t> distribution(0, k_key_count - 1);
+
+        std::vector<std::string> identifiers(size);
+        for (auto& identifier : identifiers)
+        {
+            identifier = make_identifier(distribution(generator));
+        }
+
+        return identifiers;
+    }
+
+    void BM_translate_view_per_call(benchmark::State& state)
+    {
+        const auto& translator = shared_translator();
+        const auto names = make_screen(static_cast<std::size_t>(state.range(0)));
+        const std::vector<std::string_view> identifiers(names.begin(), names.end());
+        std::vector<std::optional<std::string_view>> translations(identifiers.size());
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < identifiers.size(); ++i)
+            {
+                translations[i] = translator.translate_view(identifiers[i]);
+            }
+
+            benchmark::DoNotOptimize(translations.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_translate_view_per_call)->Arg(16)->Arg(256)->Arg(4096);
+
+    void BM_translate_batch(benchmark::State& state)
+    {
+        const auto& translator = shared_translator();
+        const auto names = make_screen(static_cast<std::size_t>(state.range(0)));
+        const std::vector<std::string_view> identifiers(names.begin(), names.end());
+        std::vector<std::optional<std::string_view>> translations(identifiers.size());
+
+        for (auto _ : state)
+        {
+            translator.translate_batch(identifiers, translations);
+
+            benchmark::DoNotOptimize(translations.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_translate_batch)->Arg(16)->Arg(256)->Arg(4096);
+
+} // namespace
@@ -0,0 +1,453 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "allocation-counter.hxx"
+
+#include <linguist/translation-catalog.hxx>
+#include <linguist/translator.hxx>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace
+{
+    constexpr const char* k_locales[] = { "en-US", "fr-FR", "de-DE", "es-ES", "it-IT", "pt-BR", "nl-NL", "ja-JP", "ko-KR", "zh-CN" };
+
+    /// Number of locales shipped in the split catalog benchmarks, of which three are used
+    constexpr std::size_t k_shipped_locales = 30;
+
+    auto identifier(std::size_t key) -> std::string
+    {
+        return "settings.item" + std::to_string(key) + ".title";
+    }
+
+    auto text(std::size_t key, const char* locale) -> std::string
+    {
+        return "Translated text for item " + std::to_string(key) + " in " + locale;
+    }
+
+    /// Synthetic JSON catalog with every identifier translated into every locale
+    auto make_json(std::size_t key_count) -> std::string
+    {
+        std::string json = "{";
+        for (std::size_t key = 0; key < key_count; ++key)
+        {
+            json += (key == 0 ? "\"" : ",\"") + identifier(key) + "\":{";
+            for (const auto* locale : k_locales)
+            {
+                json += (locale == k_locales[0] ? "\"" : ",\"") + std::string(locale) + "\":\"" + text(key, locale) + "\"";
+            }
+            json += "}";
+        }
+
+        return json + "}";
+    }
+
+    /// Write the synthetic catalog as a binary catalog file
+    auto make_catalog_file(std::size_t key_count) -> std::filesystem::path
+    {
+        linguist::translation_table::builder builder;
+        for (std::size_t key = 0; key < key_count; ++key)
+        {
+            for (const auto* locale : k_locales)
+            {
+                builder.add(identifier(key), locale, text(key, locale));
+            }
+        }
+
+        const auto path = std::filesystem::temp_directory_path() / ("linguist-bench-" + std::to_string(key_count) + ".lcat");
+        std::ofstream output(path, std::ios::binary);
+        linguist::write_catalog(output, builder.build());
+        if (!output)
+        {
+            throw std::runtime_error("failed to write benchmark catalog");
+        }
+
+        return path;
+    }
+
+    /// Synthetic locale code (e.g., "l07-XX")
+    auto shipped_locale(std::size_t locale) -> std::string
+    {
+        return "l" + std::string(locale < 10 ? "0" : "") + std::to_string(locale) + "-XX";
+    }
+
+    /// Synthetic JSON catalog holding the given shipped locales
+    auto make_shipped_json(std::size_t key_count, std::size_t first_locale, std::size_t locale_count) -> std::string
+    {
+        std::string json = "{";
+        for (std::size_t key = 0; key < key_count; ++key)
+        {
+            json += (key == 0 ? "\"" : ",\"") + identifier(key) + "\":{";
+            for (std::size_t locale = first_locale; locale < first_locale + locale_count; ++locale)
+            {
+                const auto code = shipped_locale(locale);
+                json += (locale == first_locale ? "\"" : ",\"") + code + "\":\"" + text(key, code.c_str()) + "\"";
+            }
+            json += "}";
+        }
+
+        return json + "}";
+    }
+
+    /// Write every shipped locale into one JSON file, and each into a file of its own
+    auto make_shipped_files(std::size_t key_count) -> std::filesystem::path
+    {
+        const auto directory = std::filesystem::temp_directory_path() / ("linguist-bench-locales-" + std::to_string(key_count));
+        std::filesystem::create_directories(directory / "split");
+
+        std::ofstream(directory / "all.json", std::ios::binary) << make_shipped_json(key_count, 0, k_shipped_locales);
+        for (std::size_t locale = 0; locale < k_shipped_locales; ++locale)
+        {
+            std::ofstream(directory / "split" / (shipped_locale(locale) + ".json"), std::ios::binary) << make_shipped_json(key_count, locale, 1);
+        }
+
+        return directory;
+    }
+
+    /// Write each shipped locale into a binary catalog of its own
+    auto make_shipped_catalogs(std::size_t key_count, linguist::catalog_compression compression) -> std::filesystem::path
+    {
+        const auto directory = std::filesystem::temp_directory_path() /
+            ("linguist-bench-catalogs-" + std::to_string(key_count) + "-" + std::to_string(static_cast<std::uint32_t>(compression)));
+        std::filesystem::create_directories(directory);
+
+        for (std::size_t locale = 0; locale < k_shipped_locales; ++locale)
+        {
+            const auto code = shipped_locale(locale);
+            linguist::translation_table::builder builder;
+            for (std::size_t key = 0; key < key_count; ++key)
+            {
+                builder.add(identifier(key), code, text(key, code.c_str()));
+            }
+
+            std::ofstream output(directory / (code + ".lcat"), std::ios::binary);
+            linguist::write_catalog(output, builder.build(), compression);
+            if (!output)
+            {
+                throw std::runtime_error("failed to write benchmark catalog");
+            }
+        }
+
+        return directory;
+    }
+
+    /// Total size of the files in a directory
+    auto directory_bytes(const std::filesystem::path& directory) -> std::size_t
+    {
+        std::size_t bytes = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            bytes += entry.file_size();
+        }
+
+        return bytes;
+    }
+
+    /// Use three of the shipped locales, as a typical server process does
+    void use_three_locales(linguist::translator& translator)
+    {
+        translator.set_locale(shipped_locale(0));
+        benchmark::DoNotOptimize(translator.translate(identifier(0), shipped_locale(1), true));
+        benchmark::DoNotOptimize(translator.translate(identifier(0), shipped_locale(2), true));
+    }
+
+    /// Loader used before streaming: parse a JSON document, then convert it
+    auto load_json_document(const std::string& json) -> linguist::translation_table
+    {
+        const auto document = nlohmann::json::parse(json);
+
+        linguist::translation_table::builder builder;
+        for (const auto& [identifier, locale_map] : document.items())
+        {
+            for (const auto& [locale, text] : locale_map.items())
+            {
+                builder.add(identifier, locale, text.get<std::string>());
+            }
+        }
+
+        return builder.build();
+    }
+
+    void BM_load_json_document(benchmark::State& state)
+    {
+        const auto json = make_json(state.range(0));
+        std::size_t peak = 0;
+
+        for (auto _ : state)
+        {
+            const auto bytes = linguist::bench::allocated_bytes();
+            linguist::bench::reset_peak_allocated_bytes();
+            benchmark::DoNotOptimize(load_json_document(json));
+            peak = linguist::bench::peak_allocated_bytes() - bytes;
+        }
+
+        state.counters["json_bytes"] = static_cast<double>(json.size());
+        state.counters["peak_bytes"] = static_cast<double>(peak);
+    }
+    BENCHMARK(BM_load_json_document)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+    void BM_load_from_string(benchmark::State& state)
+    {
+        const auto json = make_json(state.range(0));
+        const auto allocations = linguist::bench::allocation_count();
+        std::size_t peak = 0;
+
+        for (auto _ : state)
+        {
+            linguist::translator translator;
+            const auto bytes = linguist::bench::allocated_bytes();
+            linguist::bench::reset_peak_allocated_bytes();
+            benchmark::DoNotOptimize(translator.load_from_string(json));
+            peak = linguist::bench::peak_allocated_bytes() - bytes;
+        }
+
+        state.counters["allocs_per_load"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+        state.counters["json_bytes"] = static_cast<double>(json.size());
+        state.counters["peak_bytes"] = static_cast<double>(peak);
+    }
+    BENCHMARK(BM_load_from_string)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+    void BM_load_startup_path(benchmark::State& state)
+    {
+        // Time the caller is blocked for: the whole load, or starting it on a background thread
+        const auto path = std::filesystem::temp_directory_path() / "linguist-bench-startup.json";
+        std::ofstream(path, std::ios::binary) << make_json(state.range(0));
+        const bool background = state.range(1) != 0;
+
+        for (auto _ : state)
+        {
+            std::optional<linguist::translator> translator(std::in_place, linguist::catalog());
+            if (background)
+            {
+                auto loaded = translator->load_from_file_async(path);
+                state.PauseTiming();
+                benchmark::DoNotOptimize(loaded.get());
+            }
+            else
+            {
+                benchmark::DoNotOptimize(translator->load_from_file(path));
+                state.PauseTiming();
+            }
+
+            translator.reset();
+            state.ResumeTiming();
+        }
+
+        std::filesystem::remove(path);
+    }
+    BENCHMARK(BM_load_startup_path)
+        ->ArgNames({ "keys", "background" })
+        ->ArgsProduct({ { 1000, 10000, 50000 }, { 0, 1 } })
+        ->Iterations(20)
+        ->Unit(benchmark::kMicrosecond);
+
+    void BM_construct_translator(benchmark::State& state)
+    {
+        // Construction with the embedded translations resolved in place, or on a background thread
+        const bool background = state.range(0) != 0;
+
+        for (auto _ : state)
+        {
+            std::optional<linguist::translator> translator;
+            if (background)
+            {
+                translator.emplace(linguist::background_load);
+            }
+            else
+            {
+                translator.emplace();
+            }
+
+            state.PauseTiming();
+            translator.reset();
+            state.ResumeTiming();
+        }
+    }
+    BENCHMARK(BM_construct_translator)->ArgName("background")->Arg(0)->Arg(1)->Iterations(200)->Unit(benchmark::kMicrosecond);
+
+    void BM_teardown_catalog(benchmark::State& state)
+    {
+        // Only releasing the last reference to a loaded catalog is timed
+        const auto json = make_json(state.range(0));
+        std::size_t blocks = 0;
+        std::string error;
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            const auto before = linguist::bench::allocated_blocks();
+            auto translations = linguist::catalog::from_string(json, error);
+            blocks = linguist::bench::allocated_blocks() - before;
+            state.ResumeTiming();
+
+            translations.reset();
+        }
+
+        state.counters["catalog_blocks"] = static_cast<double>(blocks);
+    }
+    BENCHMARK(BM_teardown_catalog)->Arg(1000)->Arg(10000)->Arg(50000)->Iterations(20)->Unit(benchmark::kMicrosecond);
+
+    void BM_reload_fragmentation(benchmark::State& state)
+    {
+        // Reload two catalogs of different sizes in turn, 1000 times, keeping a small allocation
+        // between reloads as a long-running process does, then compare the heap taken from the
+        // system with the bytes still allocated: the difference is free but fragmented heap.
+        // Heap taken after the first reload shows whether fragmentation grows with reloads
+#if defined(__GLIBC__)
+        const auto json = make_json(state.range(0));
+        const auto smaller = make_json(state.range(0) * 3 / 4);
+        constexpr std::size_t cycles = 1000;
+
+        for (auto _ : state)
+        {
+            const auto start = mallinfo2();
+            const auto bytes = linguist::bench::allocated_bytes();
+            linguist::translator translator;
+            std::vector<std::string> retained;
+            retained.reserve(cycles);
+
+            auto first = start;
+            for (std::size_t cycle = 0; cycle < cycles; ++cycle)
+            {
+                benchmark::DoNotOptimize(translator.load_from_string(cycle % 2 == 0 ? json : smaller));
+                retained.emplace_back(48, 'x');
+                if (cycle == 0)
+                {
+                    first = mallinfo2();
+                }
+            }
+
+            const auto end = mallinfo2();
+            state.counters["heap_bytes"] = static_cast<double>(end.arena + end.hblkhd) - static_cast<double>(start.arena + start.hblkhd);
+            state.counters["heap_after_first_bytes"] = static_cast<double>(end.arena + end.hblkhd) - static_cast<double>(first.arena + first.hblkhd);
+            state.counters["live_bytes"] = static_cast<double>(linguist::bench::allocated_bytes() - bytes);
+            state.counters["free_bytes"] = static_cast<double>(end.fordblks);
+        }
+#else
+        state.SkipWithError("heap statistics require glibc");
+#endif
+    }
+    BENCHMARK(BM_reload_fragmentation)->Arg(1000)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+    void BM_load_mapped(benchmark::State& state)
+    {
+        const auto path = make_catalog_file(state.range(0));
+        linguist::translator translator;
+
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(translator.load_mapped(path));
+        }
+
+        state.counters["allocs_per_load"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+
+        std::filesystem::remove(path);
+    }
+    BENCHMARK(BM_load_mapped)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+    void BM_load_all_locales(benchmark::State& state)
+    {
+        const auto directory = make_shipped_files(state.range(0));
+        std::size_t resident = 0;
+
+        for (auto _ : state)
+        {
+            const auto bytes = linguist::bench::allocated_bytes();
+            linguist::translator translator;
+            benchmark::DoNotOptimize(translator.load_from_file(directory / "all.json"));
+            use_three_locales(translator);
+            resident = linguist::bench::allocated_bytes() - bytes;
+        }
+
+        state.counters["resident_bytes"] = static_cast<double>(resident);
+
+        std::filesystem::remove_all(directory);
+    }
+    BENCHMARK(BM_load_all_locales)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+    void BM_load_split_locales(benchmark::State& state)
+    {
+        const auto directory = make_shipped_files(state.range(0));
+        std::size_t resident = 0;
+
+        for (auto _ : state)
+        {
+            const auto bytes = linguist::bench::allocated_bytes();
+            linguist::translator translator;
+            benchmark::DoNotOptimize(translator.load_directory(directory / "split"));
+            use_three_locales(translator);
+            resident = linguist::bench::allocated_bytes() - bytes;
+        }
+
+        state.counters["resident_bytes"] = static_cast<double>(resident);
+
+        std::filesystem::remove_all(directory);
+    }
+    BENCHMARK(BM_load_split_locales)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+    void BM_load_split_catalogs(benchmark::State& state)
+    {
+        // Mapped catalogs take no heap, and compressed ones are decompressed when their locale is used
+        const auto compression = static_cast<linguist::catalog_compression>(state.range(1));
+        const auto directory = make_shipped_catalogs(state.range(0), compression);
+        std::size_t resident = 0;
+
+        for (auto _ : state)
+        {
+            const auto bytes = linguist::bench::allocated_bytes();
+            linguist::translator translator;
+            benchmark::DoNotOptimize(translator.load_directory(directory));
+            use_three_locales(translator);
+            resident = linguist::bench::allocated_bytes() - bytes;
+        }
+
+        state.counters["disk_bytes"] = static_cast<double>(directory_bytes(directory));
+        state.counters["resident_bytes"] = static_cast<double>(resident);
+
+        std::filesystem::remove_all(directory);
+    }
+    BENCHMARK(BM_load_split_catalogs)->ArgsProduct({ { 1000, 10000 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+    void BM_translate_evicted_locale(benchmark::State& state)
+    {
+        // A one-byte limit evicts each locale when the next is set, so every switch loads its locale again
+        const auto compression = static_cast<linguist::catalog_compression>(state.range(1));
+        const auto directory = make_shipped_catalogs(state.range(0), compression);
+        linguist::translator translator;
+        if (!translator.load_directory(directory, 1))
+        {
+            state.SkipWithError("failed to load benchmark catalogs");
+            return;
+        }
+
+        std::size_t locale = 0;
+        for (auto _ : state)
+        {
+            translator.set_locale(shipped_locale(++locale % 2));
+            benchmark::DoNotOptimize(translator.translate_view(identifier(0)));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+
+        std::filesystem::remove_all(directory);
+    }
+    BENCHMARK(BM_translate_evicted_locale)->ArgsProduct({ { 1000, 10000 }, { 0, 1 } })->Unit(benchmark::kMicrosecond);
+
+} // namespace
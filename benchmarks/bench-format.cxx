@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "allocation-counter.hxx"
+
+#include <linguist/sample-keys.hxx>
+#include <linguist/translator.hxx>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    // Message with a placeholder, a plural and a nested select.
+    constexpr const char* k_pattern =
+        "{name} added {count, plural, =0 {nothing} one {# file} other {# files}} to {gender, select, female {her} male {his} other {their}} folder";
+
+    void BM_format_to_precompiled(benchmark::State& state)
+    {
+        // Compiled once, as the loader and embed tool do
+        std::vector<linguist::message_op> ops;
+        std::string error;
+        if (!linguist::compile_message(k_pattern, ops, error))
+        {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+
+        const linguist::message message(k_pattern, ops);
+        const auto rule = linguist::plural_rule_for("en-US");
+        std::array<char, 256> buffer{};
+        std::int64_t count = 0;
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            const std::array arguments = { linguist::message_argument("name", "Ada"), linguist::message_argument("count", ++count % 4),
+                linguist::message_argument("gender", "female") };
+            benchmark::DoNotOptimize(message.format_to(buffer, arguments, rule));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.counters["allocs_per_message"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_format_to_precompiled);
+
+    void BM_format_to_parse_each_call(benchmark::State& state)
+    {
+        // Baseline: the template is parsed again for every message
+        const auto rule = linguist::plural_rule_for("en-US");
+        std::array<char, 256> buffer{};
+        std::vector<linguist::message_op> ops;
+        std::string error;
+        std::int64_t count = 0;
+
+        for (auto _ : state)
+        {
+            ops.clear();
+            static_cast<void>(linguist::compile_message(k_pattern, ops, error));
+
+            const std::array arguments = { linguist::message_argument("name", "Ada"), linguist::message_argument("count", ++count % 4),
+                linguist::message_argument("gender", "female") };
+            benchmark::DoNotOptimize(linguist::message(k_pattern, ops).format_to(buffer, arguments, rule));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_format_to_parse_each_call);
+
+    void BM_translator_format_to_key(benchmark::State& state)
+    {
+        // Embedded message looked up by key handle and formatted in place
+        linguist::translator translator;
+        translator.set_locale("fr-FR");
+        std::array<char, 256> buffer{};
+        std::int64_t count = 0;
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            const std::array arguments = { linguist::message_argument("count", ++count % 4) };
+            benchmark::DoNotOptimize(translator.format_to(linguist::keys::cart_items, buffer, arguments));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.counters["allocs_per_message"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_translator_format_to_key);
+
+} // namespace
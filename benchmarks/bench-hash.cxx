@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "synthetic-catalog.hxx"
+
+#include <linguist/translation-table.hxx>
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    /// Number of identifiers in each key length benchmark
+    constexpr std::size_t k_key_count = 10000;
+
+    /// Key lengths of the sweep, in bytes
+    void key_lengths(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->ArgName("length");
+        for (const std::int64_t length : { 8, 16, 24, 32, 48, 64, 96, 128 })
+        {
+            benchmark->Arg(length);
+        }
+    }
+
+    /// Identifiers of one length, differing only at their end as in nested settings keys
+    auto make_catalog(const benchmark::State& state) -> linguist::bench::synthetic_catalog
+    {
+        return linguist::bench::synthetic_catalog::generate({ .keys = k_key_count, .locales = 1, .identifier_length = static_cast<std::size_t>(state.range(0)) });
+    }
+
+    void BM_hash_identifier(benchmark::State& state)
+    {
+        const auto catalog = make_catalog(state);
+        const auto queries = catalog.random_identifiers(4096);
+        std::size_t next = 0;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(linguist::hash_identifier(queries[next]));
+            next = (next + 1) & (queries.size() - 1);
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_hash_identifier)->Apply(key_lengths);
+
+    void BM_hash_std(benchmark::State& state)
+    {
+        // The standard library's hash, as used by std::unordered_map<std::string, ...>
+        const auto catalog = make_catalog(state);
+        const auto queries = catalog.random_identifiers(4096);
+        std::size_t next = 0;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(std::hash<std::string_view>{}(queries[next]));
+            next = (next + 1) & (queries.size() - 1);
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_hash_std)->Apply(key_lengths);
+
+    void BM_find_key_length(benchmark::State& state)
+    {
+        // Hash, probe and compare against identifiers sharing all but their last bytes
+        const auto catalog = make_catalog(state);
+        const auto queries = catalog.random_identifiers(4096);
+
+        linguist::translation_table::builder builder;
+        for (const auto& identifier : catalog.identifiers)
+        {
+            builder.add(identifier, "en", "text");
+        }
+
+        const auto table = builder.build();
+        std::size_t next = 0;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(table.find(queries[next]));
+            next = (next + 1) & (queries.size() - 1);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_find_key_length)->Apply(key_lengths);
+
+} // namespace
@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "allocation-counter.hxx"
+#include "synthetic-catalog.hxx"
+
+#include <linguist/translator.hxx>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    /// Number of distinct identifiers each lookup benchmark cycles through
+    constexpr std::size_t k_lookup_keys = 4096;
+
+    /// Catalog shapes of the sweep: keys, locales and text length
+    void catalog_shapes(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->ArgNames({ "keys", "locales", "length" });
+        for (const std::int64_t keys : { 100, 10000, 100000 })
+        {
+            benchmark->Args({ keys, 10, 32 });
+        }
+
+        benchmark->Args({ 10000, 2, 32 });
+        benchmark->Args({ 10000, 30, 32 });
+        benchmark->Args({ 10000, 10, 8 });
+        benchmark->Args({ 10000, 10, 256 });
+    }
+
+    auto shape_of(const benchmark::State& state) -> linguist::bench::catalog_shape
+    {
+        return { static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)), static_cast<std::size_t>(state.range(2)) };
+    }
+
+    /// Translator holding a synthetic catalog, with its current locale set
+    auto make_translator(const linguist::bench::synthetic_catalog& catalog, const std::string& locale) -> linguist::translator
+    {
+        linguist::translator translator;
+        if (!translator.load_from_string(catalog.json()))
+        {
+            throw std::runtime_error("failed to load benchmark catalog");
+        }
+
+        translator.set_locale(locale);
+        return translator;
+    }
+
+    /// Identifiers spread over the whole catalog, in random order, so that lookups are not served from one cache line
+    auto lookup_order(const std::vector<std::string>& identifiers) -> std::vector<std::string>
+    {
+        std::vector<std::string> order;
+        for (std::size_t i = 0; i < std::min(k_lookup_keys, identifiers.size()); ++i)
+        {
+            order.push_back(identifiers[i * identifiers.size() / std::min(k_lookup_keys, identifiers.size())]);
+        }
+
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+        return order;
+    }
+
+    /// Look up identifiers in turn with translate(), counting allocations per lookup
+    void run_translate(benchmark::State& state, const linguist::translator& translator, const std::vector<std::string>& identifiers)
+    {
+        const auto allocations = linguist::bench::allocation_count();
+        std::size_t next = 0;
+
+        for (auto _ : state)
+        {
+            auto translation = translator.translate(identifiers[next]);
+            benchmark::DoNotOptimize(translation);
+            next = next + 1 == identifiers.size() ? 0 : next + 1;
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.counters["allocs_per_lookup"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+
+    void BM_translate_exact(benchmark::State& state)
+    {
+        const auto catalog = linguist::bench::synthetic_catalog::generate(shape_of(state));
+        const auto translator = make_translator(catalog, catalog.locales.back());
+        run_translate(state, translator, lookup_order(catalog.identifiers));
+    }
+    BENCHMARK(BM_translate_exact)->Apply(catalog_shapes);
+
+    void BM_translate_base_language(benchmark::State& state)
+    {
+        // A region the catalog lacks resolves through the base language
+        const auto catalog = linguist::bench::synthetic_catalog::generate(shape_of(state));
+        const auto translator = make_translator(catalog, catalog.other_region(catalog.locales.size() - 1));
+        run_translate(state, translator, lookup_order(catalog.identifiers));
+    }
+    BENCHMARK(BM_translate_base_language)->Apply(catalog_shapes);
+
+    void BM_translate_first_available(benchmark::State& state)
+    {
+        // A language the catalog lacks falls back to the first available translation
+        const auto catalog = linguist::bench::synthetic_catalog::generate(shape_of(state));
+        const auto translator = make_translator(catalog, "xx-XX");
+        run_translate(state, translator, lookup_order(catalog.identifiers));
+    }
+    BENCHMARK(BM_translate_first_available)->Apply(catalog_shapes);
+
+    void BM_translate_miss(benchmark::State& state)
+    {
+        const auto catalog = linguist::bench::synthetic_catalog::generate(shape_of(state));
+        const auto translator = make_translator(catalog, catalog.locales.back());
+        run_translate(state, translator, catalog.missing_identifiers(k_lookup_keys));
+    }
+    BENCHMARK(BM_translate_miss)->Apply(catalog_shapes);
+
+    void BM_translate_statistics(benchmark::State& state)
+    {
+        // Statistics off, counting only, or counting and timing one lookup in 64
+        const auto catalog = linguist::bench::synthetic_catalog::generate({ 10000, 10, 32 });
+        auto translator = make_translator(catalog, catalog.locales.back());
+        if (state.range(0) > 0)
+        {
+            translator.enable_statistics({ .latency_sample_interval = state.range(0) > 1 ? 64u : 0u });
+        }
+
+        run_translate(state, translator, lookup_order(catalog.identifiers));
+    }
+    BENCHMARK(BM_translate_statistics)->ArgName("statistics")->DenseRange(0, 2);
+
+    void BM_has_translation_exact(benchmark::State& state)
+    {
+        const auto catalog = linguist::bench::synthetic_catalog::generate(shape_of(state));
+        const auto translator = make_translator(catalog, catalog.locales.back());
+        const auto identifiers = lookup_order(catalog.identifiers);
+        std::size_t next = 0;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(translator.has_translation(identifiers[next]));
+            next = next + 1 == identifiers.size() ? 0 : next + 1;
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_has_translation_exact)->Apply(catalog_shapes);
+
+    void BM_get_available_locales(benchmark::State& state)
+    {
+        const auto catalog = linguist::bench::synthetic_catalog::generate(shape_of(state));
+        const auto translator = make_translator(catalog, catalog.locales.back());
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(translator.get_available_locales());
+        }
+
+        state.counters["allocs_per_call"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_get_available_locales)->Apply(catalog_shapes);
+
+    void BM_available_locales(benchmark::State& state)
+    {
+        const auto catalog = linguist::bench::synthetic_catalog::generate(shape_of(state));
+        const auto translator = make_translator(catalog, catalog.locales.back());
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            std::size_t translated = 0;
+            for (const auto& locale : translator.available_locales())
+            {
+                translated += locale.translated;
+            }
+
+            benchmark::DoNotOptimize(translated);
+        }
+
+        state.counters["allocs_per_call"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_available_locales)->Apply(catalog_shapes);
+
+    /// Accept-Language headers of browsers set to the last locale of a catalog, through its base language or another region
+    auto accept_language_headers(const linguist::bench::synthetic_catalog& catalog) -> std::vector<std::string>
+    {
+        const auto& locale = catalog.locales.back();
+        const auto language = locale.substr(0, locale.find('-'));
+        return { locale + "," + language + ";q=0.9,en;q=0.8", catalog.other_region(catalog.locales.size() - 1) + ", en;q=0.5",
+            "xx-XX, " + language + ";q=0.7, *;q=0.1" };
+    }
+
+    void BM_negotiate_locale(benchmark::State& state)
+    {
+        // Parse and match every request's header
+        const auto catalog = linguist::bench::synthetic_catalog::generate({ 100, static_cast<std::size_t>(state.range(0)), 32 });
+        const auto translator = make_translator(catalog, catalog.locales.back());
+        const linguist::locale_negotiator negotiator(translator.get_catalog());
+        const auto headers = accept_language_headers(catalog);
+        const auto allocations = linguist::bench::allocation_count();
+        std::size_t next = 0;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(negotiator.find_locale(headers[next]));
+            next = next + 1 == headers.size() ? 0 : next + 1;
+        }
+
+        state.counters["allocs_per_call"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_negotiate_locale)->ArgName("locales")->Arg(2)->Arg(10)->Arg(30);
+
+    void BM_negotiate_cached_view(benchmark::State& state)
+    {
+        // Resolve each header's view once, then reuse it
+        const auto catalog = linguist::bench::synthetic_catalog::generate({ 100, static_cast<std::size_t>(state.range(0)), 32 });
+        const auto translator = make_translator(catalog, catalog.locales.back());
+        const linguist::locale_negotiator negotiator(translator.get_catalog());
+        const auto headers = accept_language_headers(catalog);
+        const auto allocations = linguist::bench::allocation_count();
+        std::size_t next = 0;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(negotiator.negotiate(headers[next]));
+            next = next + 1 == headers.size() ? 0 : next + 1;
+        }
+
+        state.counters["allocs_per_call"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_negotiate_cached_view)->ArgName("locales")->Arg(2)->Arg(10)->Arg(30);
+
+    void BM_load_synthetic_catalog(benchmark::State& state)
+    {
+        const auto json = linguist::bench::synthetic_catalog::generate(shape_of(state)).json();
+        linguist::translator translator;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(translator.load_from_string(json));
+        }
+
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(json.size()));
+    }
+    BENCHMARK(BM_load_synthetic_catalog)->Apply(catalog_shapes)->Unit(benchmark::kMillisecond);
+
+} // namespace
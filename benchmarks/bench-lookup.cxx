@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "allocation-counter.hxx"
+
+#include <linguist/sample-keys.hxx>
+#include <linguist/translator.hxx>
+
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    // Keys and text long enough to defeat the small-string optimisation.
+    constexpr const char* k_identifier = "settings.account.privacy.title";
+
+    const std::string k_catalog = R"({
+        "settings.account.privacy.title": {
+            "en-US": "Privacy and security settings",
+            "fr-FR": "Paramètres de confidentialité et de sécurité"
+        }
+    })";
+
+    // Regional catalog without en-GB, so en-GB lookups resolve through the base language.
+    const std::string k_regional_catalog = R"({
+        "settings.account.privacy.title": {
+            "de-DE": "Datenschutz- und Sicherheitseinstellungen",
+            "es-ES": "Configuración de privacidad y seguridad",
+            "fr-FR": "Paramètres de confidentialité et de sécurité",
+            "it-IT": "Impostazioni di privacy e sicurezza",
+            "ja-JP": "プライバシーとセキュリティの設定",
+            "nl-NL": "Privacy- en beveiligingsinstellingen",
+            "pt-BR": "Configurações de privacidade e segurança",
+            "en-US": "Privacy and security settings"
+        }
+    })";
+
+    auto make_translator(const char* locale, const std::string& catalog = k_catalog) -> linguist::translator
+    {
+        linguist::translator translator;
+        if (!translator.load_from_string(catalog))
+        {
+            throw std::runtime_error("failed to load benchmark catalog");
+        }
+
+        translator.set_locale(locale);
+        return translator;
+    }
+
+    void BM_translate(benchmark::State& state)
+    {
+        const auto translator = make_translator("fr-FR");
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            auto translation = translator.translate(k_identifier);
+            benchmark::DoNotOptimize(translation);
+        }
+
+        state.counters["allocs_per_lookup"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_translate);
+
+    void BM_translate_view(benchmark::State& state)
+    {
+        const auto translator = make_translator("fr-FR");
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            auto translation = translator.translate_view(k_identifier);
+            benchmark::DoNotOptimize(translation);
+        }
+
+        state.counters["allocs_per_lookup"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_translate_view);
+
+    void BM_translate_view_shared(benchmark::State& state)
+    {
+        // One translator read by every benchmark thread
+        static const auto translator = make_translator("fr-FR");
+
+        for (auto _ : state)
+        {
+            auto translation = translator.translate_view(k_identifier);
+            benchmark::DoNotOptimize(translation);
+        }
+    }
+    BENCHMARK(BM_translate_view_shared)->ThreadRange(1, 8);
+
+    void BM_snapshot_translate_view(benchmark::State& state)
+    {
+        // Taking a snapshot per lookup pays for the shared reference count
+        static const auto translator = make_translator("fr-FR");
+
+        for (auto _ : state)
+        {
+            auto translation = translator.snapshot()->translate_view(k_identifier);
+            benchmark::DoNotOptimize(translation);
+        }
+    }
+    BENCHMARK(BM_snapshot_translate_view)->ThreadRange(1, 8);
+
+    // Locales served by the multi-threaded benchmarks, one per thread in turn.
+    constexpr const char* k_thread_locales[] = { "de-DE", "es-ES", "fr-FR", "it-IT", "ja-JP", "nl-NL", "pt-BR", "en-US" };
+
+    auto thread_locale(const benchmark::State& state) -> const char*
+    {
+        return k_thread_locales[static_cast<std::size_t>(state.thread_index()) % std::size(k_thread_locales)];
+    }
+
+    void BM_locale_view_threads(benchmark::State& state)
+    {
+        // Every thread serves its own locale from one shared catalog
+        static const auto translations = []()
+        {
+            std::string error;
+            auto translations = linguist::catalog::from_string(k_regional_catalog, error);
+            if (!translations)
+            {
+                throw std::runtime_error("failed to load benchmark catalog");
+            }
+
+            return *translations;
+        }();
+
+        const auto view = translations.view(thread_locale(state));
+
+        for (auto _ : state)
+        {
+            auto translation = view.translate_view(k_identifier);
+            benchmark::DoNotOptimize(translation);
+        }
+    }
+    BENCHMARK(BM_locale_view_threads)->ThreadRange(1, 64)->UseRealTime();
+
+    void BM_locked_translator_threads(benchmark::State& state)
+    {
+        // Without views, threads serving different locales switch one translator under a lock
+        static auto translator = make_translator("en-US", k_regional_catalog);
+        static std::mutex mutex;
+        const std::string locale = thread_locale(state);
+
+        for (auto _ : state)
+        {
+            std::lock_guard lock(mutex);
+            translator.set_locale(locale);
+            auto translation = translator.translate_view(k_identifier);
+            benchmark::DoNotOptimize(translation);
+        }
+    }
+    BENCHMARK(BM_locked_translator_threads)->ThreadRange(1, 64)->UseRealTime();
+
+    void BM_translate_view_base_language(benchmark::State& state)
+    {
+        const auto translator = make_translator("en-GB", k_regional_catalog);
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            auto translation = translator.translate_view(k_identifier);
+            benchmark::DoNotOptimize(translation);
+        }
+
+        state.counters["allocs_per_lookup"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_translate_view_base_language);
+
+    void BM_translate_view_first_available(benchmark::State& state)
+    {
+        const auto translator = make_translator("ko-KR", k_regional_catalog);
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            auto translation = translator.translate_view(k_identifier);
+            benchmark::DoNotOptimize(translation);
+        }
+
+        state.counters["allocs_per_lookup"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_translate_view_first_available);
+
+    void BM_has_translation(benchmark::State& state)
+    {
+        const auto translator = make_translator("fr-FR");
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(translator.has_translation(k_identifier));
+        }
+
+        state.counters["allocs_per_lookup"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_has_translation);
+
+    void BM_translate_view_embedded(benchmark::State& state)
+    {
+        linguist::translator translator;
+        translator.set_locale("fr-FR");
+
+        for (auto _ : state)
+        {
+            auto translation = translator.translate_view("home.title");
+            benchmark::DoNotOptimize(translation);
+        }
+    }
+    BENCHMARK(BM_translate_view_embedded);
+
+    void BM_translate_view_key(benchmark::State& state)
+    {
+        linguist::translator translator;
+        translator.set_locale("fr-FR");
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            auto translation = translator.translate_view(linguist::keys::home_title);
+            benchmark::DoNotOptimize(translation);
+        }
+
+        state.counters["allocs_per_lookup"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_translate_view_key);
+
+    void BM_construct_embedded(benchmark::State& state)
+    {
+        const auto allocations = linguist::bench::allocation_count();
+
+        for (auto _ : state)
+        {
+            linguist::translator translator;
+            benchmark::DoNotOptimize(translator);
+        }
+
+        state.counters["allocs_per_construction"] = benchmark::Counter(
+            static_cast<double>(linguist::bench::allocation_count() - allocations), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_construct_embedded);
+
+} // namespace
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "synthetic-catalog.hxx"
+
+#include <linguist/translation-table.hxx>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    /// Dotted identifiers, as produced by a typical application catalog
+    auto make_catalog(const benchmark::State& state) -> linguist::bench::synthetic_catalog
+    {
+        return linguist::bench::synthetic_catalog::generate({ .keys = static_cast<std::size_t>(state.range(0)), .locales = 1 });
+    }
+
+    auto build_table(const std::vector<std::string>& identifiers, linguist::table_index index) -> linguist::translation_table
+    {
+        linguist::translation_table::builder builder;
+        for (const auto& identifier : identifiers)
+        {
+            builder.add(identifier, "en", identifier);
+        }
+
+        return builder.build(index);
+    }
+
+    void BM_find_unordered_map(benchmark::State& state)
+    {
+        const auto catalog = make_catalog(state);
+        const auto queries = catalog.random_identifiers(4096);
+
+        std::unordered_map<std::string, std::uint32_t, linguist::string_hash, std::equal_to<>> rows;
+        for (std::size_t i = 0; i < catalog.identifiers.size(); ++i)
+        {
+            rows.emplace(catalog.identifiers[i], static_cast<std::uint32_t>(i));
+        }
+
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(rows.find(queries[i++ & 4095])->second);
+        }
+    }
+    BENCHMARK(BM_find_unordered_map)->Arg(1000)->Arg(10000)->Arg(100000);
+
+    void BM_find_open_addressing(benchmark::State& state)
+    {
+        const auto catalog = make_catalog(state);
+        const auto queries = catalog.random_identifiers(4096);
+        const auto table = build_table(catalog.identifiers, linguist::table_index::open_addressing);
+
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(table.find(queries[i++ & 4095]));
+        }
+    }
+    BENCHMARK(BM_find_open_addressing)->Arg(1000)->Arg(10000)->Arg(100000);
+
+    void BM_find_perfect_hash(benchmark::State& state)
+    {
+        const auto catalog = make_catalog(state);
+        const auto queries = catalog.random_identifiers(4096);
+        const auto table = build_table(catalog.identifiers, linguist::table_index::perfect_hash);
+
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(table.find(queries[i++ & 4095]));
+        }
+    }
+    BENCHMARK(BM_find_perfect_hash)->Arg(1000)->Arg(10000)->Arg(100000);
+
+    void BM_build_perfect_hash(benchmark::State& state)
+    {
+        const auto catalog = make_catalog(state);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(build_table(catalog.identifiers, linguist::table_index::perfect_hash));
+        }
+    }
+    BENCHMARK(BM_build_perfect_hash)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+} // namespace
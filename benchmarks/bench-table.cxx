@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "allocation-counter.hxx"
+#include "synthetic-catalog.hxx"
+
+#include <linguist/translation-table.hxx>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    /// Layout used by translator before the flat translation table
+    using nested_map = std::unordered_map<std::string, std::unordered_map<std::string, std::string>>;
+
+    /// Catalog of the benchmark's keys and locales, with translations about as long as a label
+    auto make_catalog(const benchmark::State& state) -> linguist::bench::synthetic_catalog
+    {
+        return linguist::bench::synthetic_catalog::generate({ static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)), 40 });
+    }
+
+    auto build_nested(const linguist::bench::synthetic_catalog& catalog) -> nested_map
+    {
+        nested_map translations;
+        for (std::size_t key = 0; key < catalog.identifiers.size(); ++key)
+        {
+            auto& locale_map = translations[catalog.identifiers[key]];
+            for (std::size_t locale = 0; locale < catalog.locales.size(); ++locale)
+            {
+                locale_map[catalog.locales[locale]] = catalog.text(key, locale);
+            }
+        }
+
+        return translations;
+    }
+
+    auto build_table(const linguist::bench::synthetic_catalog& catalog) -> linguist::translation_table
+    {
+        linguist::translation_table::builder builder;
+        for (std::size_t key = 0; key < catalog.identifiers.size(); ++key)
+        {
+            for (std::size_t locale = 0; locale < catalog.locales.size(); ++locale)
+            {
+                builder.add(catalog.identifiers[key], catalog.locales[locale], catalog.text(key, locale));
+            }
+        }
+
+        return builder.build();
+    }
+
+    void BM_footprint_nested_map(benchmark::State& state)
+    {
+        const auto catalog = make_catalog(state);
+        for (auto _ : state)
+        {
+            const auto bytes = linguist::bench::allocated_bytes();
+            const auto blocks = linguist::bench::allocated_blocks();
+            const auto translations = build_nested(catalog);
+
+            state.counters["bytes"] = static_cast<double>(linguist::bench::allocated_bytes() - bytes);
+            state.counters["blocks"] = static_cast<double>(linguist::bench::allocated_blocks() - blocks);
+        }
+    }
+    BENCHMARK(BM_footprint_nested_map)->Args({ 1000, 30 })->Args({ 10000, 30 })->Args({ 40000, 30 })->Iterations(1)->Unit(benchmark::kMillisecond);
+
+    void BM_footprint_translation_table(benchmark::State& state)
+    {
+        const auto catalog = make_catalog(state);
+        for (auto _ : state)
+        {
+            const auto bytes = linguist::bench::allocated_bytes();
+            const auto blocks = linguist::bench::allocated_blocks();
+            const auto table = build_table(catalog);
+
+            state.counters["bytes"] = static_cast<double>(linguist::bench::allocated_bytes() - bytes);
+            state.counters["blocks"] = static_cast<double>(linguist::bench::allocated_blocks() - blocks);
+        }
+    }
+    BENCHMARK(BM_footprint_translation_table)->Args({ 1000, 30 })->Args({ 10000, 30 })->Args({ 40000, 30 })->Iterations(1)->Unit(benchmark::kMillisecond);
+
+    void BM_lookup_nested_map(benchmark::State& state)
+    {
+        const auto catalog = make_catalog(state);
+        const auto translations = build_nested(catalog);
+        const auto lookups = catalog.random_identifiers(4096);
+        const std::vector<std::string> queries(lookups.begin(), lookups.end());
+        const auto& locale = catalog.locales.back();
+
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            const auto& locale_map = translations.find(queries[i++ & 4095])->second;
+            benchmark::DoNotOptimize(locale_map.find(locale)->second.data());
+        }
+    }
+    BENCHMARK(BM_lookup_nested_map)->Args({ 1000, 30 })->Args({ 10000, 30 })->Args({ 40000, 30 });
+
+    void BM_lookup_translation_table(benchmark::State& state)
+    {
+        const auto catalog = make_catalog(state);
+        const auto table = build_table(catalog);
+        const auto queries = catalog.random_identifiers(4096);
+        const auto locale = *table.find_locale(catalog.locales.back());
+
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(table.text(table.find(queries[i++ & 4095]), locale));
+        }
+    }
+    BENCHMARK(BM_lookup_translation_table)->Args({ 1000, 30 })->Args({ 10000, 30 })->Args({ 40000, 30 });
+
+} // namespace
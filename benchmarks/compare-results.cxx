@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+    /// Read the CPU time of each benchmark in a Google Benchmark JSON report, in nanoseconds
+    ///
+    /// Repeated runs are compared by their median, so that one noisy repetition
+    /// does not fail the check.
+    auto read_results(const std::string& file) -> std::map<std::string, double>
+    {
+        std::ifstream input(file);
+        if (!input.is_open())
+        {
+            throw std::runtime_error("Cannot open benchmark results: " + file);
+        }
+
+        const auto report = nlohmann::json::parse(input);
+        const std::map<std::string, double> units = { { "ns", 1.0 }, { "us", 1e3 }, { "ms", 1e6 }, { "s", 1e9 } };
+
+        std::map<std::string, double> iterations;
+        std::map<std::string, double> medians;
+        for (const auto& benchmark : report.at("benchmarks"))
+        {
+            if (benchmark.value("error_occurred", false))
+            {
+                continue;
+            }
+
+            const auto name = benchmark.value("run_name", benchmark.at("name").get<std::string>());
+            const auto time = benchmark.at("cpu_time").get<double>() * units.at(benchmark.value("time_unit", "ns"));
+            if (benchmark.value("run_type", "iteration") == "iteration")
+            {
+                iterations.emplace(name, time);
+            }
+            else if (benchmark.value("aggregate_name", "") == "median")
+            {
+                medians[name] = time;
+            }
+        }
+
+        medians.merge(iterations);
+        return medians;
+    }
+} // namespace
+
+///
+/// Compare benchmark results with a baseline and fail on regressions
+///
+auto main(int32_t argc, char* argv[]) -> int32_t
+{
+    if (argc < 3 || argc > 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <baseline.json> <results.json> [threshold]\n";
+        std::cerr << "  Reports every benchmark whose CPU time grew by more than <threshold> percent (default 10),\n";
+        std::cerr << "  and exits with an error if there is any.\n";
+        return 2;
+    }
+
+    try
+    {
+        const auto baseline = read_results(argv[1]);
+        const auto results = read_results(argv[2]);
+        const auto threshold = argc == 4 ? std::stod(argv[3]) : 10.0;
+
+        std::size_t regressions = 0;
+        std::size_t compared = 0;
+        for (const auto& [name, time] : results)
+        {
+            const auto previous = baseline.find(name);
+            if (previous == baseline.end() || previous->second <= 0.0)
+            {
+                continue;
+            }
+
+            const auto change = (time / previous->second - 1.0) * 100.0;
+            const auto regressed = change > threshold;
+            std::printf("%-80s %12.1f ns %12.1f ns %+7.1f%%%s\n", name.c_str(), previous->second, time, change, regressed ? "  REGRESSION" : "");
+
+            ++compared;
+            regressions += regressed ? 1 : 0;
+        }
+
+        std::printf("%zu of %zu benchmarks slower than the baseline by more than %.1f%%\n", regressions, compared, threshold);
+        return regressions == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+}
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "synthetic-catalog.hxx"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <random>
+
+namespace linguist::bench
+{
+    namespace
+    {
+        constexpr const char* k_languages[] = { "en", "fr", "de", "es", "it", "pt", "nl", "sv", "da", "fi", "nb", "pl", "cs", "sk", "hu",
+            "ro", "bg", "el", "tr", "ru", "uk", "he", "ar", "hi", "th", "vi", "id", "ja", "ko", "zh" };
+
+        /// Dotted identifier of about 23 characters, grouped by screen
+        auto identifier(std::size_t key, std::string_view item) -> std::string
+        {
+            return "screen" + std::to_string(key / 64) + "." + std::string(item) + std::to_string(key) + ".title";
+        }
+
+        /// Dotted identifier of exactly length characters, sharing all but its end with the others as in nested settings keys
+        auto identifier(std::size_t key, std::size_t length) -> std::string
+        {
+            constexpr std::string_view path = "settings.account.privacy.";
+
+            const auto suffix = "." + std::to_string(key);
+            std::string identifier;
+            while (identifier.size() + suffix.size() < length)
+            {
+                identifier += path.substr(0, length - suffix.size() - identifier.size());
+            }
+
+            return identifier + suffix;
+        }
+    } // namespace
+
+    auto synthetic_catalog::generate(const catalog_shape& shape) -> synthetic_catalog
+    {
+        synthetic_catalog catalog;
+        catalog.text_length = shape.text_length;
+
+        catalog.identifiers.reserve(shape.keys);
+        for (std::size_t key = 0; key < shape.keys; ++key)
+        {
+            catalog.identifiers.push_back(shape.identifier_length == 0 ? identifier(key, "item") : identifier(key, shape.identifier_length));
+        }
+
+        // Each locale has a language of its own, so that regional variants resolve to exactly one locale
+        for (std::size_t locale = 0; locale < std::min(shape.locales, std::size(k_languages)); ++locale)
+        {
+            std::string region = k_languages[locale];
+            std::transform(region.begin(), region.end(), region.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+            catalog.locales.push_back(std::string(k_languages[locale]) + "-" + region);
+        }
+
+        return catalog;
+    }
+
+    auto synthetic_catalog::text(std::size_t key, std::size_t locale) const -> std::string
+    {
+        auto text = locales[locale] + " text " + std::to_string(key) + " ";
+        while (text.size() < text_length)
+        {
+            text += "lorem ipsum ";
+        }
+
+        text.resize(text_length);
+        return text;
+    }
+
+    auto synthetic_catalog::random_identifiers(std::size_t count) const -> std::vector<std::string_view>
+    {
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<std::size_t> distribution(0, identifiers.size() - 1);
+
+        std::vector<std::string_view> lookups(count);
+        for (auto& lookup : lookups)
+        {
+            lookup = identifiers[distribution(generator)];
+        }
+
+        return lookups;
+    }
+
+    auto synthetic_catalog::missing_identifiers(std::size_t count) const -> std::vector<std::string>
+    {
+        std::vector<std::string> missing;
+        missing.reserve(count);
+        for (std::size_t key = 0; key < count; ++key)
+        {
+            missing.push_back(identifier(key, "absent"));
+        }
+
+        return missing;
+    }
+
+    auto synthetic_catalog::other_region(std::size_t locale) const -> std::string
+    {
+        return locales[locale].substr(0, locales[locale].find('-')) + "-ZZ";
+    }
+
+    auto synthetic_catalog::json() const -> std::string
+    {
+        std::string json = "{";
+        for (std::size_t key = 0; key < identifiers.size(); ++key)
+        {
+            json += (key == 0 ? "\"" : ",\"") + identifiers[key] + "\":{";
+            for (std::size_t locale = 0; locale < locales.size(); ++locale)
+            {
+                json += (locale == 0 ? "\"" : ",\"") + locales[locale] + "\":\"" + text(key, locale) + "\"";
+            }
+            json += "}";
+        }
+
+        return json + "}";
+    }
+
+} // namespace linguist::bench
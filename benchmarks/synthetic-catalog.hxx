@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace linguist::bench
+{
+    /// Dimensions of a synthetic catalog
+    struct catalog_shape
+    {
+        /// Number of identifiers, each translated into every locale
+        std::size_t keys{ 1000 };
+
+        /// Number of locales (e.g., "fr-FR"), at most one per language
+        std::size_t locales{ 10 };
+
+        /// Length of each translation in bytes
+        std::size_t text_length{ 32 };
+
+        /// Length of each identifier in bytes, all sharing a dotted path and differing only at their end, or 0 for
+        /// identifiers of about 23 bytes grouped by screen
+        std::size_t identifier_length{ 0 };
+    };
+
+    /// Synthetic catalog of dotted identifiers translated into every locale
+    ///
+    /// The same shape always generates the same catalog, so results are
+    /// comparable between runs and builds.
+    struct synthetic_catalog
+    {
+        std::vector<std::string> identifiers;
+        std::vector<std::string> locales;
+        std::size_t text_length{ 0 };
+
+        /// Generate a catalog of the given shape
+        [[nodiscard]] static auto generate(const catalog_shape& shape) -> synthetic_catalog;
+
+        /// Get the translation of an identifier into a locale
+        ///
+        /// \param key Index of the identifier
+        /// \param locale Index of the locale
+        /// \return Text of exactly text_length bytes
+        [[nodiscard]] auto text(std::size_t key, std::size_t locale) const -> std::string;
+
+        /// Get identifiers to look up, drawn uniformly from the catalog
+        ///
+        /// \param count Number of lookups
+        /// \return Views of the catalog's identifiers, the same for every run
+        [[nodiscard]] auto random_identifiers(std::size_t count) const -> std::vector<std::string_view>;
+
+        /// Get identifiers shaped like the catalog's, none of which it holds
+        ///
+        /// \param count Number of identifiers
+        [[nodiscard]] auto missing_identifiers(std::size_t count) const -> std::vector<std::string>;
+
+        /// Get a locale of the same language as a catalog locale, but of a region the catalog lacks
+        ///
+        /// \param locale Index of the locale
+        [[nodiscard]] auto other_region(std::size_t locale) const -> std::string;
+
+        /// Write the catalog as a JSON document for translator::load_from_string()
+        [[nodiscard]] auto json() const -> std::string;
+    };
+
+} // namespace linguist::bench
@@ -5,6 +5,21 @@
 # Build and run unit-tests.
 option(BUILD_LINGUIST_TESTS "Build the testing tree." ON)
 
+# Build the micro-benchmarks.
+option(BUILD_LINGUIST_BENCHMARKS "Build the benchmark tree." OFF)
+
+# Benchmark regression check: linguist-bench-report writes the results of the
+# benchmarks matching the filter, and linguist-bench-check compares them with
+# the baseline results.
+set(LINGUIST_BENCH_FILTER "." CACHE STRING "Regular expression selecting the benchmarks to report.")
+set(LINGUIST_BENCH_REPETITIONS "5" CACHE STRING "Repetitions of each reported benchmark, compared by their median.")
+set(LINGUIST_BENCH_BASELINE "" CACHE FILEPATH "Benchmark results (JSON) that linguist-bench-check compares with.")
+set(LINGUIST_BENCH_THRESHOLD "10" CACHE STRING "Slowdown in percent that linguist-bench-check reports as a regression.")
+
+# Lookup statistics: translator::enable_statistics() counts lookups by result.
+# Without it, lookups carry no statistics code at all.
+option(BUILD_WITH_LOOKUP_STATISTICS "Build with opt-in lookup statistics." ON)
+
 # Static analysis
 if(WIN32 AND MSVC)
     set(BUILD_STATIC_ANALYSIS_MODE "VisualStudio" CACHE STRING "Enable static analysis.")
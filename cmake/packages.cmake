@@ -18,3 +18,14 @@ FetchContent_Declare(Catch2
   GIT_TAG           v3.12.0
 )
 FetchContent_MakeAvailable(Catch2)
+
+# Benchmarking framework.
+if(BUILD_LINGUIST_BENCHMARKS)
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+    FetchContent_Declare(benchmark
+      GIT_REPOSITORY    https://github.com/google/benchmark.git
+      GIT_TAG           v1.9.1
+    )
+    FetchContent_MakeAvailable(benchmark)
+endif()
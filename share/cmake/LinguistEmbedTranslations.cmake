@@ -5,38 +5,231 @@
 #
 # Embed translation JSON files into C++ source code
 #
+# embed_translation_file(
+#     INPUT_FILE      <json> | INPUT_FILES <json>...
+#     OUTPUT_VARIABLE <var>
+#     [KEYS_HEADER    <header>]
+#     [PERFECT_HASH]
+#     [SPLIT_LOCALES]
+#     [BLOB]
+#     [SHARDS         <count>]
+#     [COMPRESS]
+# )
+#
+# INPUT_FILES reads several JSON files (e.g., one per locale or feature) in
+# parallel and merges them in order; a translation defined by two files fails
+# the build. The output is named after the first file.
+#
+# KEYS_HEADER also generates <header>, relative to the current binary directory,
+# declaring a linguist::key_id constant for each identifier (e.g.,
+# linguist::keys::home_title for "home.title"). The header is appended to <var>.
+#
+# PERFECT_HASH indexes the identifiers with a minimal perfect hash computed at
+# build time, so every lookup costs one hash and one string compare.
+#
+# SPLIT_LOCALES embeds a separate table per locale. The translator then only
+# materialises the locales its fallback chain and explicit lookups use, and
+# key handles are looked up by name.
+#
+# BLOB writes the tables as binary catalogs to one file next to the generated
+# source, embedded_translations_<name>.lcat, which the source includes with
+# #embed or the assembler's .incbin instead of spelling them out as C++, so that
+# large catalogs compile in about a second. It requires a compiler supporting
+# #embed, or GCC or Clang for .incbin; MSVC has neither, so BLOB is ignored
+# there and the tables are embedded as C++ arrays. BLOB cannot be combined with
+# SHARDS, whose sources are already small enough to compile one at a time.
+#
+# SHARDS splits the tables per locale like SPLIT_LOCALES and writes them to
+# <count> source files, assigning each locale by a hash of its code. Sources
+# and the keys header are only rewritten when their content changes, so an edit
+# to one locale recompiles only the shard holding it. <var> also receives a
+# stamp file tracking the tool run.
+#
+# COMPRESS embeds each table as a compressed catalog, decompressed into memory
+# when its locale is first used. With SPLIT_LOCALES or SHARDS, idle locales are
+# dropped under the translator's memory limit and decompressed again on demand.
+#
 function(embed_translation_file)
-    set(options "")
-    set(oneValueArgs INPUT_FILE OUTPUT_VARIABLE)
-    set(multiValueArgs "")
+    set(options PERFECT_HASH SPLIT_LOCALES BLOB COMPRESS)
+    set(oneValueArgs INPUT_FILE OUTPUT_VARIABLE KEYS_HEADER SHARDS)
+    set(multiValueArgs INPUT_FILES)
     cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
 
-    if(NOT ARG_INPUT_FILE)
-        message(FATAL_ERROR "embed_translation_file: INPUT_FILE is required")
+    if(ARG_INPUT_FILE)
+        list(PREPEND ARG_INPUT_FILES "${ARG_INPUT_FILE}")
+    endif()
+
+    if(NOT ARG_INPUT_FILES)
+        message(FATAL_ERROR "embed_translation_file: INPUT_FILE or INPUT_FILES is required")
     endif()
 
     if(NOT ARG_OUTPUT_VARIABLE)
         message(FATAL_ERROR "embed_translation_file: OUTPUT_VARIABLE is required")
     endif()
 
-    # Get absolute path for input
-    if(NOT IS_ABSOLUTE "${ARG_INPUT_FILE}")
-        set(ARG_INPUT_FILE "${CMAKE_CURRENT_SOURCE_DIR}/${ARG_INPUT_FILE}")
+    if(ARG_BLOB AND ARG_SHARDS)
+        message(FATAL_ERROR "embed_translation_file: BLOB cannot be combined with SHARDS")
     endif()
 
+    # Get absolute paths for the inputs
+    set(INPUT_PATHS "")
+    foreach(INPUT_FILE IN LISTS ARG_INPUT_FILES)
+        if(NOT IS_ABSOLUTE "${INPUT_FILE}")
+            set(INPUT_FILE "${CMAKE_CURRENT_SOURCE_DIR}/${INPUT_FILE}")
+        endif()
+
+        list(APPEND INPUT_PATHS "${INPUT_FILE}")
+    endforeach()
+
+    set(ARG_INPUT_FILES ${INPUT_PATHS})
+    list(GET ARG_INPUT_FILES 0 ARG_INPUT_FILE)
+
     # Auto-generate output filename in binary directory
     get_filename_component(INPUT_NAME "${ARG_INPUT_FILE}" NAME_WE)
     set(ARG_OUTPUT_FILE "${CMAKE_CURRENT_BINARY_DIR}/embedded_translations_${INPUT_NAME}.cxx")
 
+    set(OUTPUT_FILES "${ARG_OUTPUT_FILE}")
+
+    # Collect the embed tool options
+    set(TOOL_OPTIONS "")
+    if(ARG_PERFECT_HASH)
+        list(APPEND TOOL_OPTIONS "--perfect-hash")
+    endif()
+
+    if(ARG_SPLIT_LOCALES)
+        list(APPEND TOOL_OPTIONS "--split-locales")
+    endif()
+
+    if(ARG_COMPRESS)
+        list(APPEND TOOL_OPTIONS "--compress")
+    endif()
+
+    # The catalogs, of every locale, are written to one file with the source, which is rewritten on every run
+    set(BYPRODUCT_FILES "")
+    if(ARG_BLOB AND NOT MSVC)
+        list(APPEND TOOL_OPTIONS "--blob")
+        list(APPEND BYPRODUCT_FILES "${CMAKE_CURRENT_BINARY_DIR}/embedded_translations_${INPUT_NAME}.lcat")
+    endif()
+
+    if(ARG_KEYS_HEADER)
+        set(KEYS_HEADER_FILE "${CMAKE_CURRENT_BINARY_DIR}/${ARG_KEYS_HEADER}")
+        get_filename_component(KEYS_HEADER_DIR "${KEYS_HEADER_FILE}" DIRECTORY)
+        file(MAKE_DIRECTORY "${KEYS_HEADER_DIR}")
+        list(APPEND TOOL_OPTIONS "--keys" "${KEYS_HEADER_FILE}")
+        list(APPEND OUTPUT_FILES "${KEYS_HEADER_FILE}")
+    endif()
+
+    # Unchanged shards keep their timestamps, so the tool run is tracked by a stamp file
+    set(STAMP_COMMAND "")
+    if(ARG_SHARDS)
+        list(APPEND TOOL_OPTIONS "--shards" "${ARG_SHARDS}")
+        math(EXPR LAST_SHARD "${ARG_SHARDS} - 1")
+        foreach(SHARD RANGE ${LAST_SHARD})
+            list(APPEND OUTPUT_FILES "${CMAKE_CURRENT_BINARY_DIR}/embedded_translations_${INPUT_NAME}_${SHARD}.cxx")
+        endforeach()
+
+        set(STAMP_FILE "${CMAKE_CURRENT_BINARY_DIR}/embedded_translations_${INPUT_NAME}.stamp")
+        set(STAMP_COMMAND COMMAND ${CMAKE_COMMAND} -E touch "${STAMP_FILE}")
+        list(APPEND BYPRODUCT_FILES ${OUTPUT_FILES})
+        list(APPEND OUTPUT_FILES "${STAMP_FILE}")
+        set(COMMAND_OUTPUTS "${STAMP_FILE}")
+    else()
+        set(COMMAND_OUTPUTS ${OUTPUT_FILES})
+    endif()
+
     # Add custom command to generate the embedded file
+    list(JOIN ARG_INPUT_FILES ", " INPUT_LIST)
     add_custom_command(
-        OUTPUT "${ARG_OUTPUT_FILE}"
-        COMMAND linguist-embed-tool "${ARG_INPUT_FILE}" "${ARG_OUTPUT_FILE}"
-        DEPENDS linguist-embed-tool "${ARG_INPUT_FILE}"
-        COMMENT "Embedding translations from ${ARG_INPUT_FILE}"
+        OUTPUT ${COMMAND_OUTPUTS}
+        BYPRODUCTS ${BYPRODUCT_FILES}
+        COMMAND linguist-embed-tool ${TOOL_OPTIONS} ${ARG_INPUT_FILES} "${ARG_OUTPUT_FILE}"
+        ${STAMP_COMMAND}
+        DEPENDS linguist-embed-tool ${ARG_INPUT_FILES}
+        COMMENT "Embedding translations from ${INPUT_LIST}"
         VERBATIM
     )
 
+    # Return the output file paths to parent scope
+    set(${ARG_OUTPUT_VARIABLE} ${OUTPUT_FILES} PARENT_SCOPE)
+endfunction()
+
+#
+# Compile a translation JSON file into a binary catalog for translator::load_mapped()
+#
+# compile_translation_catalog(
+#     INPUT_FILE      <json>
+#     OUTPUT_VARIABLE <var>
+#     [PERFECT_HASH]
+#     [SPLIT_LOCALES]
+#     [COMPRESS]
+# )
+#
+# The catalog is written to the current binary directory as <name>.lcat, and its
+# path is returned in <var>. Add it to a target's sources to build it.
+#
+# SPLIT_LOCALES instead writes one catalog per locale to the directory <name>,
+# for translator::load_directory(). <var> then receives a stamp file in that
+# directory, which is touched whenever the catalogs are written.
+#
+# COMPRESS writes compressed catalogs, which are decompressed into memory when
+# loaded instead of being mapped.
+#
+function(compile_translation_catalog)
+    set(options PERFECT_HASH SPLIT_LOCALES COMPRESS)
+    set(oneValueArgs INPUT_FILE OUTPUT_VARIABLE)
+    set(multiValueArgs "")
+    cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+    if(NOT ARG_INPUT_FILE)
+        message(FATAL_ERROR "compile_translation_catalog: INPUT_FILE is required")
+    endif()
+
+    if(NOT ARG_OUTPUT_VARIABLE)
+        message(FATAL_ERROR "compile_translation_catalog: OUTPUT_VARIABLE is required")
+    endif()
+
+    # Get absolute path for input
+    if(NOT IS_ABSOLUTE "${ARG_INPUT_FILE}")
+        set(ARG_INPUT_FILE "${CMAKE_CURRENT_SOURCE_DIR}/${ARG_INPUT_FILE}")
+    endif()
+
+    # Collect the embed tool options
+    set(TOOL_OPTIONS "--binary")
+    if(ARG_PERFECT_HASH)
+        list(APPEND TOOL_OPTIONS "--perfect-hash")
+    endif()
+
+    if(ARG_COMPRESS)
+        list(APPEND TOOL_OPTIONS "--compress")
+    endif()
+
+    get_filename_component(INPUT_NAME "${ARG_INPUT_FILE}" NAME_WE)
+    if(ARG_SPLIT_LOCALES)
+        # Write one catalog per locale, tracked by a stamp file
+        set(ARG_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${INPUT_NAME}")
+        set(ARG_OUTPUT_FILE "${ARG_OUTPUT_DIR}/catalogs.stamp")
+
+        add_custom_command(
+            OUTPUT "${ARG_OUTPUT_FILE}"
+            COMMAND linguist-embed-tool ${TOOL_OPTIONS} --split-locales "${ARG_INPUT_FILE}" "${ARG_OUTPUT_DIR}"
+            COMMAND ${CMAKE_COMMAND} -E touch "${ARG_OUTPUT_FILE}"
+            DEPENDS linguist-embed-tool "${ARG_INPUT_FILE}"
+            COMMENT "Compiling per-locale translation catalogs from ${ARG_INPUT_FILE}"
+            VERBATIM
+        )
+    else()
+        # Auto-generate output filename in binary directory
+        set(ARG_OUTPUT_FILE "${CMAKE_CURRENT_BINARY_DIR}/${INPUT_NAME}.lcat")
+
+        add_custom_command(
+            OUTPUT "${ARG_OUTPUT_FILE}"
+            COMMAND linguist-embed-tool ${TOOL_OPTIONS} "${ARG_INPUT_FILE}" "${ARG_OUTPUT_FILE}"
+            DEPENDS linguist-embed-tool "${ARG_INPUT_FILE}"
+            COMMENT "Compiling translation catalog from ${ARG_INPUT_FILE}"
+            VERBATIM
+        )
+    endif()
+
     # Return the output file path to parent scope
     set(${ARG_OUTPUT_VARIABLE} "${ARG_OUTPUT_FILE}" PARENT_SCOPE)
 endfunction()
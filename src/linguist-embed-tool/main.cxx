@@ -2,85 +2,1078 @@
 // Copyright (c) 2025 Jamie Kenyon. All Rights Reserved.
 //
 
+#include "linguist/json-catalog.hxx"
+#include "linguist/translation-catalog.hxx"
+#include "linguist/translation-table.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <set>
+#include <span>
+#include <sstream>
+#include <stdexcept>
 #include <string>
-#include <nlohmann/json.hpp>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
-///
-/// Build-time tool to generate embedded translation data from JSON
-///
-auto main(int32_t argc, char* argv[]) -> int32_t
+namespace
 {
-    if (argc != 3)
+    /// Escape a string for use in a generated comment or string literal
+    auto escape(std::string_view value) -> std::string
     {
-        std::cerr << "Usage: " << argv[0] << " <input.json> <output.cxx>\n";
-        return 1;
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (const char character : value)
+        {
+            const auto byte = static_cast<unsigned char>(character);
+            switch (character)
+            {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '\r':
+                escaped += "\\r";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            default:
+                if (byte < 0x20 || byte == 0x7F)
+                {
+                    // Three-digit octal escapes cannot absorb the following character
+                    escaped += '\\';
+                    escaped += static_cast<char>('0' + (byte >> 6));
+                    escaped += static_cast<char>('0' + ((byte >> 3) & 7));
+                    escaped += static_cast<char>('0' + (byte & 7));
+                }
+                else
+                {
+                    escaped += character;
+                }
+            }
+        }
+
+        return escaped;
     }
 
-    const std::string input_file = argv[1];
-    const std::string output_file = argv[2];
+    /// Write the arena as character literals, one string per line
+    void write_arena(std::ostream& output, std::string_view name, std::span<const char> arena)
+    {
+        static constexpr char digits[] = "0123456789abcdef";
 
-    try
+        output << "        // Length-prefixed, null-terminated strings.\n";
+        output << "        alignas(4) constexpr char " << name << "[] = {\n";
+
+        std::size_t offset = 0;
+        while (offset < arena.size())
+        {
+            std::uint32_t length{};
+            std::memcpy(&length, arena.data() + offset, sizeof(length));
+            const auto entry = arena.subspan(offset, sizeof(length) + length + 1);
+
+            output << "            // \"" << escape({ entry.data() + sizeof(length), length }) << "\"\n";
+            output << "           ";
+            for (const char character : entry)
+            {
+                const auto byte = static_cast<unsigned char>(character);
+                output << " '\\x" << digits[byte >> 4] << digits[byte & 0xF] << "',";
+            }
+            output << "\n";
+
+            offset += entry.size();
+        }
+
+        output << "        };\n\n";
+    }
+
+    /// Write a section of 32-bit words
+    void write_words(std::ostream& output, std::string_view comment, std::string_view name, std::span<const std::uint32_t> words)
     {
-        // Read and parse JSON
-        std::ifstream input(input_file);
-        if (!input.is_open())
+        output << "        // " << comment << "\n";
+        output << "        constexpr std::uint32_t " << name << "[] = {";
+        for (std::size_t i = 0; i < words.size(); ++i)
         {
-            std::cerr << "Error: Cannot open input file: " << input_file << "\n";
-            return 1;
+            output << (i % 8 == 0 ? "\n            " : " ") << words[i] << "u,";
         }
+        output << "\n        };\n\n";
+    }
 
-        nlohmann::json translations = nlohmann::json::parse(input);
+    /// Write the identifier index
+    void write_index(std::ostream& output, std::string_view name, std::span<const linguist::table_slot> index)
+    {
+        output << "        // Identifier index.\n";
+        output << "        constexpr table_slot " << name << "[] = {";
+        for (std::size_t i = 0; i < index.size(); ++i)
+        {
+            output << (i % 4 == 0 ? "\n            " : " ");
+            if (index[i].row == linguist::translation_table::npos)
+            {
+                output << "{},";
+            }
+            else
+            {
+                output << "{ " << index[i].tag << "u, " << index[i].row << "u },";
+            }
+        }
+        output << "\n        };\n\n";
+    }
+
+    /// Write the operations of the compiled messages
+    void write_message_ops(std::ostream& output, std::string_view name, std::span<const linguist::message_op> ops)
+    {
+        static constexpr const char* opcodes[] = { "text", "argument", "number", "plural", "select", "plural_case", "exact_case", "select_case" };
+
+        output << "        // Operations of the compiled messages.\n";
+        output << "        constexpr message_op " << name << "[] = {";
+        for (const auto& op : ops)
+        {
+            output << "\n            { message_opcode::" << opcodes[static_cast<std::size_t>(op.code)] << ", " << op.offset << "u, " << op.size << "u, "
+                   << op.value << "u, " << op.end << "u },";
+        }
+        output << "\n        };\n\n";
+    }
+
+    /// Write a table as a compressed binary catalog
+    auto compress_catalog(const linguist::translation_table& table) -> std::string
+    {
+        std::ostringstream catalog(std::ios::binary);
+        linguist::write_catalog(catalog, table, linguist::catalog_compression::lz);
+        return catalog.str();
+    }
+
+    /// Write the bytes of a compressed binary catalog
+    void write_compressed(std::ostream& output, std::string_view name, std::span<const char> catalog)
+    {
+        static constexpr char digits[] = "0123456789abcdef";
+
+        output << "        // Compressed binary catalog, decompressed on first use.\n";
+        output << "        constexpr char " << name << "[] = {";
+        for (std::size_t i = 0; i < catalog.size(); ++i)
+        {
+            const auto byte = static_cast<unsigned char>(catalog[i]);
+            output << (i % 16 == 0 ? "\n            " : " ") << "'\\x" << digits[byte >> 4] << digits[byte & 0xF] << "',";
+        }
+        output << "\n        };\n\n";
+    }
+
+    /// Write the compiled message of each translation holding placeholders
+    void write_messages(std::ostream& output, std::string_view name, std::span<const linguist::message_slot> messages)
+    {
+        output << "        // Compiled message of each translation, by arena offset.\n";
+        output << "        constexpr message_slot " << name << "[] = {";
+        for (std::size_t i = 0; i < messages.size(); ++i)
+        {
+            output << (i % 4 == 0 ? "\n            " : " ") << "{ " << messages[i].text << "u, " << messages[i].first << "u },";
+        }
+        output << "\n        };\n\n";
+    }
+
+    /// Write the constant sections of a table, naming each section with a suffix
+    void write_sections(std::ostream& output, const linguist::translation_table& table, std::string_view suffix)
+    {
+        const auto& data = table.data();
+        const auto name = [suffix](std::string_view section) { return std::string(section) + std::string(suffix); };
+
+        write_arena(output, name("arena"), data.arena);
+        write_words(output, "Arena offset of each locale code.", name("locales"), data.locales);
+        write_words(output, "Arena offset of each identifier.", name("keys"), data.keys);
+        write_index(output, name("index"), data.index);
+        write_words(output, "Arena offset of each translation, by identifier and locale.", name("matrix"), data.matrix);
+        if (!data.displacements.empty())
+        {
+            write_words(output, "Perfect hash displacement of each bucket.", name("displacements"), data.displacements);
+        }
+
+        if (!data.messages.empty())
+        {
+            write_message_ops(output, name("message_ops"), data.message_ops);
+            write_messages(output, name("messages"), data.messages);
+        }
+
+        write_words(output, "Number of identifiers translated into each locale.", name("counts"), data.counts);
+    }
+
+    /// Write the table_data initializer referencing a table's sections
+    auto sections_initializer(const linguist::translation_table& table, std::string_view suffix) -> std::string
+    {
+        if (table.empty())
+        {
+            return "{}";
+        }
+
+        std::string sections = "{ ";
+        for (const std::string_view section : { "arena", "locales", "keys", "index", "matrix" })
+        {
+            sections += std::string(section) + std::string(suffix) + ", ";
+        }
+
+        // Tables without a perfect hash have no displacements, and tables of plain text no messages
+        sections += table.data().displacements.empty() ? "{}" : "displacements" + std::string(suffix);
+        if (table.data().messages.empty())
+        {
+            sections += ", {}, {}";
+        }
+        else
+        {
+            sections += ", message_ops" + std::string(suffix) + ", messages" + std::string(suffix);
+        }
+
+        return sections + ", counts" + std::string(suffix) + " }";
+    }
+
+    /// Write the header of a generated source file
+    void write_source_header(std::ostream& output, std::string_view input_file, std::initializer_list<std::string_view> headers = { "cstdint" })
+    {
+        output << "//\n";
+        output << "// Generated file - DO NOT EDIT\n";
+        output << "// Generated from: " << input_file << "\n";
+        output << "//\n\n";
+        output << "#include <linguist/translator.hxx>\n\n";
+        for (const auto header : headers)
+        {
+            output << "#include <" << header << ">\n";
+        }
+        output << "\n";
+        output << "namespace linguist\n";
+        output << "{\n";
+    }
+
+    /// Write C++ source defining get_embedded_translations() over constant table sections
+    ///
+    /// \param compress Embed a compressed catalog, decompressed on first use, instead of the sections
+    void write_source(std::ostream& output, std::string_view input_file, const linguist::translation_table& table, bool compress)
+    {
+        write_source_header(output, input_file);
 
-        // Generate C++ source file
-        std::ofstream output(output_file);
+        // Write the constant table sections
+        if (!table.empty())
+        {
+            output << "    namespace\n";
+            output << "    {\n";
+            if (compress)
+            {
+                write_compressed(output, "compressed", compress_catalog(table));
+            }
+            else
+            {
+                write_sections(output, table, "");
+            }
+            output << "    } // namespace\n\n";
+        }
+
+        // Write the accessors referencing the sections in place, or the table decompressed once
+        output << "    auto get_embedded_translations() noexcept -> table_data\n";
+        output << "    {\n";
+        if (compress && !table.empty())
+        {
+            output << "        static const auto table = view_compressed_catalog(compressed);\n";
+            output << "        return table ? table->data() : table_data{};\n";
+        }
+        else
+        {
+            output << "        return " << sections_initializer(table, "") << ";\n";
+        }
+        output << "    }\n\n";
+        output << "    auto get_embedded_locales() noexcept -> std::span<const embedded_locale>\n";
+        output << "    {\n";
+        output << "        return {};\n";
+        output << "    }\n\n";
+        output << "} // namespace linguist\n";
+    }
+
+    /// Write the constant sections of one table per locale and the embedded_locales array referencing them
+    ///
+    /// \param compress Embed a compressed catalog per locale instead of its sections
+    void write_locale_sections(std::ostream& output, const std::vector<std::pair<std::string, linguist::translation_table>>& tables, bool compress)
+    {
+        output << "    namespace\n";
+        output << "    {\n";
+        for (std::size_t i = 0; i < tables.size(); ++i)
+        {
+            output << "        // Locale \"" << escape(tables[i].first) << "\".\n\n";
+            if (compress)
+            {
+                write_compressed(output, "compressed_" + std::to_string(i), compress_catalog(tables[i].second));
+            }
+            else
+            {
+                write_sections(output, tables[i].second, "_" + std::to_string(i));
+            }
+        }
+
+        output << "        constexpr embedded_locale embedded_locales[] = {\n";
+        for (std::size_t i = 0; i < tables.size(); ++i)
+        {
+            const auto suffix = "_" + std::to_string(i);
+            output << "            { \"" << escape(tables[i].first) << "\", "
+                   << (compress ? "{}, compressed" + suffix : sections_initializer(tables[i].second, suffix)) << " },\n";
+        }
+        output << "        };\n";
+        output << "    } // namespace\n\n";
+    }
+
+    /// Write C++ source defining get_embedded_locales() over constant sections of one table per locale
+    void write_split_source(std::ostream& output, std::string_view input_file,
+        const std::vector<std::pair<std::string, linguist::translation_table>>& tables, bool compress)
+    {
+        write_source_header(output, input_file);
+        write_locale_sections(output, tables, compress);
+
+        // Write the accessors referencing the sections in place
+        output << "    auto get_embedded_translations() noexcept -> table_data\n";
+        output << "    {\n";
+        output << "        return {};\n";
+        output << "    }\n\n";
+        output << "    auto get_embedded_locales() noexcept -> std::span<const embedded_locale>\n";
+        output << "    {\n";
+        output << "        return embedded_locales;\n";
+        output << "    }\n\n";
+        output << "} // namespace linguist\n";
+    }
+
+    /// Write C++ source defining one shard of the per-locale tables
+    void write_shard_source(std::ostream& output, std::string_view input_file, std::size_t shard,
+        const std::vector<std::pair<std::string, linguist::translation_table>>& tables, bool compress)
+    {
+        write_source_header(output, input_file);
+        if (!tables.empty())
+        {
+            write_locale_sections(output, tables, compress);
+        }
+
+        output << "    auto get_embedded_shard_" << shard << "() noexcept -> std::span<const embedded_locale>\n";
+        output << "    {\n";
+        output << "        return " << (tables.empty() ? "{}" : "embedded_locales") << ";\n";
+        output << "    }\n\n";
+        output << "} // namespace linguist\n";
+    }
+
+    /// Write C++ source defining get_embedded_locales() over the locales of every shard
+    ///
+    /// The source only depends on the number of shards, so it is never rewritten
+    /// when translations change.
+    void write_shard_index_source(std::ostream& output, std::string_view input_file, std::size_t shard_count)
+    {
+        write_source_header(output, input_file, { "cstdint", "vector" });
+        for (std::size_t shard = 0; shard < shard_count; ++shard)
+        {
+            output << "    auto get_embedded_shard_" << shard << "() noexcept -> std::span<const embedded_locale>;\n";
+        }
+        output << "\n";
+
+        output << "    auto get_embedded_translations() noexcept -> table_data\n";
+        output << "    {\n";
+        output << "        return {};\n";
+        output << "    }\n\n";
+        output << "    auto get_embedded_locales() noexcept -> std::span<const embedded_locale>\n";
+        output << "    {\n";
+        output << "        // The locales of the shards are joined once, in shard order\n";
+        output << "        static const auto locales = []\n";
+        output << "        {\n";
+        output << "            std::vector<embedded_locale> joined;\n";
+        output << "            for (const auto shard : {";
+        for (std::size_t shard = 0; shard < shard_count; ++shard)
+        {
+            output << (shard == 0 ? " " : ", ") << "get_embedded_shard_" << shard << "()";
+        }
+        output << " })\n";
+        output << "            {\n";
+        output << "                joined.insert(joined.end(), shard.begin(), shard.end());\n";
+        output << "            }\n\n";
+        output << "            return joined;\n";
+        output << "        }();\n\n";
+        output << "        return locales;\n";
+        output << "    }\n\n";
+        output << "} // namespace linguist\n";
+    }
+
+    /// Write a text file unless it already has the same content
+    ///
+    /// Leaving unchanged files untouched keeps their timestamps, so build
+    /// systems do not recompile what includes them.
+    ///
+    /// \return true if the file was written
+    auto write_if_changed(const std::filesystem::path& file, const std::string& content) -> bool
+    {
+        if (std::ifstream existing(file, std::ios::binary); existing.is_open())
+        {
+            const std::string current((std::istreambuf_iterator<char>(existing)), std::istreambuf_iterator<char>());
+            if (current == content)
+            {
+                return false;
+            }
+        }
+
+        std::ofstream output(file, std::ios::binary);
         if (!output.is_open())
         {
-            std::cerr << "Error: Cannot open output file: " << output_file << "\n";
-            return 1;
+            throw std::runtime_error("Cannot open output file: " + file.string());
+        }
+
+        output << content;
+        if (!output)
+        {
+            throw std::runtime_error("Cannot write output file: " + file.string());
         }
 
-        // Write header
+        return true;
+    }
+
+    /// Binary catalog stored within a blob
+    struct blob_catalog
+    {
+        /// Locale code, empty unless the catalogs are split per locale
+        std::string locale;
+
+        /// Offset of the catalog within the blob, a multiple of 8
+        std::size_t offset{ 0 };
+        std::size_t size{ 0 };
+    };
+
+    /// Write C++ source defining the embedded accessors over a blob of binary catalogs included at compile time
+    ///
+    /// The blob is included with #embed where the compiler supports it and with
+    /// the assembler's .incbin elsewhere, so the compiler never parses the
+    /// translations and the source compiles in the same time at any size.
+    ///
+    /// \param blob_file Path of the blob, holding every catalog
+    /// \param catalogs Locale code, empty unless split, and position of each catalog within the blob
+    /// \param compress Whether the catalogs are compressed, and so decompressed on first use
+    void write_blob_source(std::ostream& output, std::string_view input_file, const std::filesystem::path& blob_file,
+        const std::vector<blob_catalog>& catalogs, bool split, bool compress)
+    {
         output << "//\n";
         output << "// Generated file - DO NOT EDIT\n";
         output << "// Generated from: " << input_file << "\n";
         output << "//\n\n";
-        output << "#include <string>\n";
-        output << "#include <unordered_map>\n\n";
+        output << "#include <linguist/translation-catalog.hxx>\n";
+        output << "#include <linguist/translator.hxx>\n\n";
+        output << "#include <cstdint>\n";
+        output << "#include <span>\n\n";
+
+        // Select how the catalogs are included
+        output << "#if defined(__has_embed)\n";
+        output << "#define LINGUIST_CATALOG(name) std::span<const unsigned char>(name)\n";
+        output << "#elif defined(__GNUC__)\n";
+        output << "#define LINGUIST_CATALOG(name) std::span<const unsigned char>(name, name##_end)\n";
+        output << "#if defined(__APPLE__)\n";
+        output << "#define LINGUIST_CATALOG_SECTION \".const_data\\n\"\n";
+        output << "#define LINGUIST_PREVIOUS_SECTION \".text\\n\"\n";
+        output << "#elif defined(_WIN32)\n";
+        output << "#define LINGUIST_CATALOG_SECTION \".section .rdata,\\\"dr\\\"\\n\"\n";
+        output << "#define LINGUIST_PREVIOUS_SECTION \".text\\n\"\n";
+        output << "#else\n";
+        output << "#define LINGUIST_CATALOG_SECTION \".pushsection .rodata\\n\"\n";
+        output << "#define LINGUIST_PREVIOUS_SECTION \".popsection\\n\"\n";
+        output << "#endif\n";
+        output << "#else\n";
+        output << "#error \"Embedding binary catalogs requires #embed or .incbin; embed the translations as C++ source instead\"\n";
+        output << "#endif\n\n";
         output << "namespace linguist\n";
-        output << "{\n\n";
+        output << "{\n";
+
+        // Include the blob, 8-byte aligned so that its catalogs can be viewed in place
+        const std::string name = "embedded_catalogs";
+        const auto path = blob_file.generic_string();
+        if (!catalogs.empty())
+        {
+            output << "#if defined(__has_embed)\n";
+            output << "    alignas(8) static constexpr unsigned char " << name << "[] = {\n";
+            output << "#embed \"" << path << "\"\n";
+            output << "    };\n";
+            output << "#else\n";
+            output << "    extern const unsigned char " << name << "[] __asm__(\"linguist_" << name << "\");\n";
+            output << "    extern const unsigned char " << name << "_end[] __asm__(\"linguist_" << name << "_end\");\n";
+            output << "    __asm__(LINGUIST_CATALOG_SECTION \".balign 8\\n\" \"linguist_" << name << ":\\n\" \".incbin \\\""
+                   << escape(escape(path)) << "\\\"\\n\" \"linguist_" << name << "_end:\\n\" LINGUIST_PREVIOUS_SECTION);\n";
+            output << "#endif\n\n";
+        }
+
+        // Each catalog is a span of the blob
+        const auto catalog_span = [&](const blob_catalog& catalog)
+        { return "LINGUIST_CATALOG(" + name + ").subspan(" + std::to_string(catalog.offset) + ", " + std::to_string(catalog.size) + ")"; };
+
+        output << "    namespace\n";
+        output << "    {\n";
+        if (compress)
+        {
+            output << "        auto bytes(std::span<const unsigned char> catalog) noexcept -> std::span<const char>\n";
+            output << "        {\n";
+            output << "            return { reinterpret_cast<const char*>(catalog.data()), catalog.size() };\n";
+            output << "        }\n";
+        }
+        else
+        {
+            output << "        // The catalogs were validated when they were written\n";
+            output << "        auto view(std::span<const unsigned char> catalog) noexcept -> table_data\n";
+            output << "        {\n";
+            output << "            return read_catalog({ reinterpret_cast<const char*>(catalog.data()), catalog.size() }).value_or(table_data{});\n";
+            output << "        }\n";
+        }
+        output << "    } // namespace\n\n";
 
-        // Write the embedded data structure
-        output << "auto get_embedded_translations() -> std::unordered_map<std::string, std::unordered_map<std::string, std::string>>\n";
+        // Write the accessors viewing the catalogs in place, or the catalog decompressed once
+        output << "    auto get_embedded_translations() noexcept -> table_data\n";
+        output << "    {\n";
+        if (split || catalogs.empty())
+        {
+            output << "        return {};\n";
+        }
+        else if (compress)
+        {
+            output << "        static const auto table = view_compressed_catalog(bytes(" << catalog_span(catalogs[0]) << "));\n";
+            output << "        return table ? table->data() : table_data{};\n";
+        }
+        else
+        {
+            output << "        return view(" << catalog_span(catalogs[0]) << ");\n";
+        }
+        output << "    }\n\n";
+        output << "    auto get_embedded_locales() noexcept -> std::span<const embedded_locale>\n";
+        output << "    {\n";
+        if (split && !catalogs.empty())
+        {
+            output << "        static const embedded_locale locales[] = {\n";
+            for (const auto& catalog : catalogs)
+            {
+                const auto span = catalog_span(catalog);
+                output << "            { \"" << escape(catalog.locale) << "\", " << (compress ? "{}, bytes(" + span + ")" : "view(" + span + ")") << " },\n";
+            }
+            output << "        };\n";
+            output << "        return locales;\n";
+        }
+        else
+        {
+            output << "        return {};\n";
+        }
+        output << "    }\n\n";
+        output << "} // namespace linguist\n";
+    }
+
+    /// Read a length-prefixed string from the arena
+    auto read_string(std::span<const char> arena, std::uint32_t offset) -> std::string_view
+    {
+        std::uint32_t length{};
+        std::memcpy(&length, arena.data() + offset, sizeof(length));
+        return { arena.data() + offset + sizeof(length), length };
+    }
+
+    /// Split a table into one table per locale, in locale order
+    auto split_locales(const linguist::translation_table& table, linguist::table_index index)
+        -> std::vector<std::pair<std::string, linguist::translation_table>>
+    {
+        const auto& data = table.data();
+
+        std::vector<std::pair<std::string, linguist::translation_table>> tables;
+        tables.reserve(table.locale_count());
+        for (std::size_t locale = 0; locale < table.locale_count(); ++locale)
+        {
+            const auto id = static_cast<linguist::locale_id>(locale);
+            const auto code = table.locale(id);
+
+            linguist::translation_table::builder builder;
+            for (std::uint32_t row = 0; row < table.size(); ++row)
+            {
+                if (auto text = table.text(row, id); text)
+                {
+                    builder.add(read_string(data.arena, data.keys[row]), code, *text);
+                }
+            }
+
+            tables.emplace_back(code, builder.build(index));
+        }
+
+        return tables;
+    }
+
+    /// Report the translations whose placeholders are malformed, which are embedded as plain text
+    void check_messages(std::string_view input_file, const linguist::translation_table& table)
+    {
+        const auto& data = table.data();
+
+        std::vector<linguist::message_op> ops;
+        std::string error;
+        for (std::uint32_t row = 0; row < table.size(); ++row)
+        {
+            for (std::size_t locale = 0; locale < table.locale_count(); ++locale)
+            {
+                const auto id = static_cast<linguist::locale_id>(locale);
+                const auto text = table.text(row, id);
+                if (!text || text->find_first_of("{'") == std::string_view::npos || linguist::compile_message(*text, ops, error))
+                {
+                    ops.clear();
+                    continue;
+                }
+
+                std::cerr << "Warning: " << input_file << ": \"" << escape(read_string(data.arena, data.keys[row])) << "\" ("
+                          << table.locale(id) << "): " << error << "; the translation is used as plain text\n";
+            }
+        }
+    }
+
+    /// Convert an identifier into a C++ name (e.g., "home.title" -> "home_title")
+    auto to_key_name(std::string_view identifier) -> std::string
+    {
+        static const std::set<std::string, std::less<>> reserved = { "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand",
+            "bitor", "bool", "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const",
+            "consteval", "constexpr", "constinit", "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default",
+            "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend",
+            "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+            "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return", "short", "signed", "sizeof",
+            "static", "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw", "true", "try",
+            "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor",
+            "xor_eq" };
+
+        std::string name;
+        name.reserve(identifier.size() + 1);
+        for (const char character : identifier)
+        {
+            const auto byte = static_cast<unsigned char>(character);
+            const bool alphanumeric = (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte >= '0' && byte <= '9');
+            name += alphanumeric ? character : '_';
+        }
+
+        if (name.empty() || (name.front() >= '0' && name.front() <= '9') || reserved.contains(name))
+        {
+            name.insert(name.begin(), '_');
+        }
+
+        return name;
+    }
+
+    /// Write a header declaring a key_id constant for each identifier
+    void write_keys_header(std::ostream& output, std::string_view input_file, const linguist::translation_table& table)
+    {
+        const auto& data = table.data();
+
+        output << "//\n";
+        output << "// Generated file - DO NOT EDIT\n";
+        output << "// Generated from: " << input_file << "\n";
+        output << "//\n\n";
+        output << "#pragma once\n\n";
+        output << "#include <linguist/key-id.hxx>\n\n";
+        output << "namespace linguist::keys\n";
         output << "{\n";
-        output << "    return {\n";
 
-        // Generate entries
-        for (auto& [key, locale_map] : translations.items())
+        std::set<std::string, std::less<>> names;
+        for (std::uint32_t row = 0; row < data.keys.size(); ++row)
         {
-            output << "        {\"" << key << "\", {\n";
+            const auto identifier = read_string(data.arena, data.keys[row]);
+            auto name = to_key_name(identifier);
+            if (!names.insert(name).second)
+            {
+                throw std::runtime_error("identifier \"" + escape(identifier) + "\" maps to the duplicate key name " + name);
+            }
+
+            output << "    inline constexpr key_id " << name << "{ " << row << "u, \"" << escape(identifier) << "\" };\n";
+        }
+
+        output << "} // namespace linguist::keys\n";
+    }
+
+    /// Translations read from one input file
+    struct input_catalog
+    {
+        std::string file;
+        linguist::translation_table::builder builder;
+        linguist::translation_table table;
+        std::string error;
+    };
+
+    /// Read the input files in parallel, each into its own builder
+    ///
+    /// \param files Input JSON files
+    /// \param build Whether to also build each file's table, to merge the files
+    /// \return Translations of each file, in the order given
+    auto read_inputs(const std::vector<std::string>& files, bool build) -> std::vector<input_catalog>
+    {
+        std::vector<input_catalog> inputs(files.size());
+        std::atomic<std::size_t> next{ 0 };
 
-            for (auto& [locale, text] : locale_map.items())
+        // Each worker claims the next unread file until none are left
+        const auto read = [&]
+        {
+            for (auto i = next++; i < inputs.size(); i = next++)
             {
-                // Escape quotes in the text
-                std::string escaped_text = text.get<std::string>();
-                size_t pos = 0;
-                while ((pos = escaped_text.find('"', pos)) != std::string::npos)
+                auto& input = inputs[i];
+                input.file = files[i];
+                try
+                {
+                    std::ifstream stream(input.file, std::ios::binary);
+                    if (!stream.is_open())
+                    {
+                        input.error = "Cannot open input file: " + input.file;
+                        continue;
+                    }
+
+                    // Build the table exactly as the runtime loader would
+                    if (std::string error; !linguist::read_json_catalog(stream, input.builder, error))
+                    {
+                        input.error = input.file + ": " + error;
+                        continue;
+                    }
+
+                    if (build)
+                    {
+                        input.table = input.builder.build();
+                    }
+                }
+                catch (const std::exception& e)
                 {
-                    escaped_text.replace(pos, 1, "\\\"");
-                    pos += 2;
+                    input.error = input.file + ": " + e.what();
                 }
+            }
+        };
+
+        const auto thread_count = std::min<std::size_t>(inputs.size(), std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::jthread> workers;
+        for (std::size_t i = 1; i < thread_count; ++i)
+        {
+            workers.emplace_back(read);
+        }
 
-                output << "            {\"" << locale << "\", \"" << escaped_text << "\"},\n";
+        // The workers may still be filling their last input, so they are joined before it is returned
+        read();
+        workers.clear();
+        return inputs;
+    }
+
+    /// Merge the input files in order, reporting every translation defined by more than one file
+    ///
+    /// \param inputs Translations of each file, with their tables built
+    /// \param merged Builder receiving every translation
+    /// \return Number of conflicting translations
+    auto merge_inputs(const std::vector<input_catalog>& inputs, linguist::translation_table::builder& merged) -> std::size_t
+    {
+        std::size_t conflicts = 0;
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            const auto& table = inputs[i].table;
+            const auto& data = table.data();
+
+            // Only earlier files translating the same locale can conflict
+            std::vector<std::vector<std::pair<std::size_t, linguist::locale_id>>> earlier(table.locale_count());
+            for (std::size_t locale = 0; locale < table.locale_count(); ++locale)
+            {
+                for (std::size_t j = 0; j < i; ++j)
+                {
+                    if (const auto other = inputs[j].table.find_locale(table.locale(static_cast<linguist::locale_id>(locale))); other)
+                    {
+                        earlier[locale].emplace_back(j, *other);
+                    }
+                }
             }
 
-            output << "        }},\n";
+            // Add the translations row by row, keeping the identifiers in file order
+            for (std::uint32_t row = 0; row < table.size(); ++row)
+            {
+                const auto identifier = read_string(data.arena, data.keys[row]);
+                for (std::size_t locale = 0; locale < table.locale_count(); ++locale)
+                {
+                    const auto id = static_cast<linguist::locale_id>(locale);
+                    const auto text = table.text(row, id);
+                    if (!text)
+                    {
+                        continue;
+                    }
+
+                    for (const auto& [j, other] : earlier[locale])
+                    {
+                        const auto& other_table = inputs[j].table;
+                        if (const auto other_row = other_table.find(identifier);
+                            other_row != linguist::translation_table::npos && other_table.text(other_row, other))
+                        {
+                            std::cerr << "Error: \"" << escape(identifier) << "\" (" << table.locale(id) << ") is defined in both " << inputs[j].file
+                                      << " and " << inputs[i].file << "\n";
+                            ++conflicts;
+                            break;
+                        }
+                    }
+
+                    merged.add(identifier, table.locale(id), *text);
+                }
+            }
         }
 
-        output << "    };\n";
-        output << "}\n\n";
-        output << "} // namespace linguist\n";
+        return conflicts;
+    }
+
+} // namespace
+
+///
+/// Build-time tool to generate embedded translation data from JSON
+///
+auto main(int32_t argc, char* argv[]) -> int32_t
+{
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+
+    // Parse options
+    auto index = linguist::table_index::open_addressing;
+    bool binary = false;
+    bool blob = false;
+    bool split = false;
+    bool compress = false;
+    std::size_t shard_count = 0;
+    std::string keys_file;
+    while (!arguments.empty() && arguments.front().starts_with("--"))
+    {
+        if (arguments.front() == "--perfect-hash")
+        {
+            index = linguist::table_index::perfect_hash;
+        }
+        else if (arguments.front() == "--binary")
+        {
+            binary = true;
+        }
+        else if (arguments.front() == "--blob")
+        {
+            blob = true;
+        }
+        else if (arguments.front() == "--split-locales")
+        {
+            split = true;
+        }
+        else if (arguments.front() == "--compress")
+        {
+            compress = true;
+        }
+        else if (arguments.front() == "--shards" && arguments.size() > 1)
+        {
+            arguments.erase(arguments.begin());
+            const auto& count = arguments.front();
+            if (std::from_chars(count.data(), count.data() + count.size(), shard_count).ec != std::errc{} || shard_count == 0)
+            {
+                arguments.clear();
+                break;
+            }
+        }
+        else if (arguments.front() == "--keys" && arguments.size() > 1)
+        {
+            arguments.erase(arguments.begin());
+            keys_file = arguments.front();
+        }
+        else
+        {
+            arguments.clear();
+            break;
+        }
+
+        arguments.erase(arguments.begin());
+    }
+
+    if (arguments.size() < 2 || (binary && blob) || (shard_count > 0 && (binary || blob)))
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--perfect-hash] [--keys <output.hxx>] [--binary | --blob | --shards <count>] [--split-locales] [--compress]"
+                     " <input.json>... <output>\n";
+        std::cerr << "  --binary         Write a binary catalog for translator::load_mapped() instead of C++ source\n";
+        std::cerr << "  --blob           Write the binary catalogs of every locale to <output> with the .lcat extension, which <output>\n";
+        std::cerr << "                   includes with #embed or .incbin (not MSVC) instead of spelling the translations out as C++\n";
+        std::cerr << "  --shards         Split the translations per locale into <count> sources named <output>_<n>, assigned by\n";
+        std::cerr << "                   locale code; sources whose content is unchanged are not rewritten\n";
+        std::cerr << "  --split-locales  Split the translations into one table per locale, loaded on demand; with\n";
+        std::cerr << "                   --binary, <output> is a directory of <locale>.lcat files for translator::load_directory()\n";
+        std::cerr << "  --compress       Compress each catalog, trading a decompression when a locale is first used\n";
+        std::cerr << "                   for a smaller binary or file\n";
+        std::cerr << "Several input files are read in parallel and merged in order; a translation defined by two files is an error.\n";
+        return 1;
+    }
+
+    const std::vector<std::string> input_files(arguments.begin(), arguments.end() - 1);
+    const std::string output_file = arguments.back();
+    const auto compression = compress ? linguist::catalog_compression::lz : linguist::catalog_compression::none;
+
+    std::string input_file = input_files.front();
+    for (std::size_t i = 1; i < input_files.size(); ++i)
+    {
+        input_file += ", " + input_files[i];
+    }
+
+    try
+    {
+        // Read and parse each JSON file, merging them if there are several
+        auto inputs = read_inputs(input_files, input_files.size() > 1);
+        for (const auto& input : inputs)
+        {
+            if (!input.error.empty())
+            {
+                std::cerr << "Error: " << input.error << "\n";
+                return 1;
+            }
+        }
+
+        linguist::translation_table::builder merged;
+        if (inputs.size() > 1)
+        {
+            if (const auto conflicts = merge_inputs(inputs, merged); conflicts > 0)
+            {
+                std::cerr << "Error: " << conflicts << " conflicting translations between input files\n";
+                return 1;
+            }
+        }
+
+        const auto table = (inputs.size() > 1 ? merged : inputs.front().builder).build(index);
+        check_messages(input_file, table);
+
+        // Generate one binary catalog per locale
+        if (binary && split)
+        {
+            std::filesystem::create_directories(output_file);
+            for (const auto& [locale, locale_table] : split_locales(table, index))
+            {
+                const auto catalog_file = std::filesystem::path(output_file) / (locale + ".lcat");
+                std::ofstream output(catalog_file, std::ios::binary);
+                if (!output.is_open())
+                {
+                    std::cerr << "Error: Cannot open output file: " << catalog_file.string() << "\n";
+                    return 1;
+                }
+
+                linguist::write_catalog(output, locale_table, compression);
+            }
+        }
+        else if (shard_count > 0)
+        {
+            // Assign each locale to a shard by its code, so that editing a locale only changes its shard
+            std::vector<std::vector<std::pair<std::string, linguist::translation_table>>> shards(shard_count);
+            for (auto& locale_table : split_locales(table, index))
+            {
+                shards[linguist::hash_identifier(locale_table.first) % shard_count].push_back(std::move(locale_table));
+            }
+
+            const std::filesystem::path output_path(output_file);
+            for (std::size_t shard = 0; shard < shard_count; ++shard)
+            {
+                const auto shard_file =
+                    output_path.parent_path() / (output_path.stem().string() + "_" + std::to_string(shard) + output_path.extension().string());
+
+                std::ostringstream source;
+                write_shard_source(source, input_file, shard, shards[shard], compress);
+                if (write_if_changed(shard_file, source.str()))
+                {
+                    std::cout << "Generated " << shard_file.string() << " from " << input_file << "\n";
+                }
+            }
+
+            std::ostringstream source;
+            write_shard_index_source(source, input_file, shard_count);
+            write_if_changed(output_path, source.str());
+        }
+        else if (blob)
+        {
+            // Write the catalogs to one blob next to the source including it, by absolute path
+            std::vector<std::pair<std::string, linguist::translation_table>> tables;
+            if (split)
+            {
+                tables = split_locales(table, index);
+            }
+            else
+            {
+                tables.emplace_back(std::string(), table);
+            }
+
+            // One blob whatever the locales, so that the build system knows every file the tool writes
+            const auto blob_file = std::filesystem::absolute(output_file).replace_extension(".lcat");
+            std::ofstream blob(blob_file, std::ios::binary);
+            if (!blob.is_open())
+            {
+                std::cerr << "Error: Cannot open output file: " << blob_file.string() << "\n";
+                return 1;
+            }
+
+            // Each catalog starts 8-byte aligned, as its sections do
+            std::vector<blob_catalog> catalogs;
+            std::size_t blob_size = 0;
+            for (const auto& [locale, locale_table] : tables)
+            {
+                std::ostringstream catalog(std::ios::binary);
+                linguist::write_catalog(catalog, locale_table, compression);
+                const auto bytes = catalog.str();
+
+                const auto offset = (blob_size + 7) / 8 * 8;
+                blob << std::string(offset - blob_size, '\0');
+                blob.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+                catalogs.push_back({ locale, offset, bytes.size() });
+                blob_size = offset + bytes.size();
+            }
+
+            if (!blob)
+            {
+                std::cerr << "Error: Cannot write output file: " << blob_file.string() << "\n";
+                return 1;
+            }
+
+            std::ofstream output(output_file);
+            if (!output.is_open())
+            {
+                std::cerr << "Error: Cannot open output file: " << output_file << "\n";
+                return 1;
+            }
+
+            write_blob_source(output, input_file, blob_file, catalogs, split, compress);
+        }
+        else
+        {
+            // Generate binary catalog or C++ source file
+            std::ofstream output(output_file, binary ? std::ios::binary : std::ios::out);
+            if (!output.is_open())
+            {
+                std::cerr << "Error: Cannot open output file: " << output_file << "\n";
+                return 1;
+            }
+
+            if (binary)
+            {
+                linguist::write_catalog(output, table, compression);
+            }
+            else if (split)
+            {
+                write_split_source(output, input_file, split_locales(table, index), compress);
+            }
+            else
+            {
+                write_source(output, input_file, table, compress);
+            }
+        }
+
+        // Generate the key handles header, which shards leave untouched unless the identifiers change
+        if (!keys_file.empty() && shard_count > 0)
+        {
+            std::ostringstream keys;
+            write_keys_header(keys, input_file, table);
+            if (write_if_changed(keys_file, keys.str()))
+            {
+                std::cout << "Generated " << keys_file << " from " << input_file << "\n";
+            }
+        }
+        else if (!keys_file.empty())
+        {
+            std::ofstream keys(keys_file);
+            if (!keys.is_open())
+            {
+                std::cerr << "Error: Cannot open output file: " << keys_file << "\n";
+                return 1;
+            }
+
+            write_keys_header(keys, input_file, table);
+            std::cout << "Generated " << keys_file << " from " << input_file << "\n";
+        }
 
         std::cout << "Generated " << output_file << " from " << input_file << "\n";
         return 0;
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include <memory>
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+#include <atomic>
+#else
+#include <mutex>
+#endif
+
+namespace linguist
+{
+    /// Shared pointer that can be loaded and replaced concurrently
+    ///
+    /// Uses std::atomic<std::shared_ptr> where the standard library provides it,
+    /// and otherwise guards the pointer with a mutex held only while it is copied.
+    ///
+    template <typename T>
+    class atomic_shared_ptr
+    {
+    public:
+        /// Construct a null pointer
+        atomic_shared_ptr() = default;
+
+        /// Disable copy
+        atomic_shared_ptr(const atomic_shared_ptr&) = delete;
+
+        /// Disable copy
+        atomic_shared_ptr& operator=(const atomic_shared_ptr&) = delete;
+
+        /// Get the current pointer
+        ///
+        /// \return Shared ownership of the current value
+        [[nodiscard]] auto load() const -> std::shared_ptr<T>
+        {
+#if defined(__cpp_lib_atomic_shared_ptr)
+            return value_.load(std::memory_order_acquire);
+#else
+            std::lock_guard lock(mutex_);
+            return value_;
+#endif
+        }
+
+        /// Replace the current pointer
+        ///
+        /// The previous value is released outside of any lock.
+        ///
+        /// \param value New value
+        void store(std::shared_ptr<T> value)
+        {
+#if defined(__cpp_lib_atomic_shared_ptr)
+            value = value_.exchange(std::move(value), std::memory_order_acq_rel);
+#else
+            std::lock_guard lock(mutex_);
+            value_.swap(value);
+#endif
+        }
+
+    private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+        std::atomic<std::shared_ptr<T>> value_;
+#else
+        mutable std::mutex mutex_;
+        std::shared_ptr<T> value_;
+#endif
+    };
+
+} // namespace linguist
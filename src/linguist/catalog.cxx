@@ -0,0 +1,760 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/catalog.hxx"
+#include "linguist/json-catalog.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <memory_resource>
+
+namespace linguist
+{
+    namespace
+    {
+        /// Indices of the locales probed by a lookup, in order
+        struct locale_indices
+        {
+            std::array<std::size_t, locale_chain::capacity> values{};
+            std::size_t size{ 0 };
+
+            /// Whether the first locale is the exact locale, rather than a fallback
+            bool exact{ false };
+
+            /// Append a locale unless it is already present
+            void append(std::size_t locale)
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    if (values[i] == locale)
+                    {
+                        return;
+                    }
+                }
+
+                values[size++] = locale;
+            }
+        };
+
+        /// Get the code of a locale held by a table
+        auto locale_at(const translation_table& table, std::size_t locale) -> std::string_view
+        {
+            return table.locale(static_cast<locale_id>(locale));
+        }
+
+        /// Get the code of a locale held by a cache
+        auto locale_at(const locale_cache& cache, std::size_t locale) -> std::string_view
+        {
+            return cache.locale(locale);
+        }
+
+        /// Resolve the fallback chain of a locale among the available locales
+        template <typename Locales>
+        auto collect_locales(const Locales& locales, std::string_view current_locale, std::string_view default_locale) -> locale_indices
+        {
+            locale_indices chain;
+
+            // Exact locale match (e.g., "en-US")
+            if (auto id = locales.find_locale(current_locale); id)
+            {
+                chain.append(*id);
+                chain.exact = true;
+            }
+
+            // Base language (e.g., "en" from "en-US"), followed by the regional
+            // variants that share it (e.g., "en-GB")
+            const size_t dashPos = current_locale.find('-');
+            if (dashPos != std::string_view::npos)
+            {
+                const std::string_view baseLocale = current_locale.substr(0, dashPos);
+                if (auto id = locales.find_locale(baseLocale); id)
+                {
+                    chain.append(*id);
+                }
+
+                for (std::size_t i = 0; i < locales.locale_count() && chain.size < locale_chain::capacity - 1; ++i)
+                {
+                    const std::string_view locale = locale_at(locales, i);
+                    if (locale.size() > dashPos && locale.starts_with(baseLocale) && locale[dashPos] == '-')
+                    {
+                        chain.append(i);
+                    }
+                }
+            }
+
+            // Configured default locale
+            if (auto id = locales.find_locale(default_locale); id)
+            {
+                chain.append(*id);
+            }
+
+            return chain;
+        }
+
+        /// Get the translation of an identifier in a locale of a table
+        auto find_text(const translation_table& table, std::string_view identifier, std::string_view locale) -> std::optional<std::string_view>
+        {
+            const auto id = table.find_locale(locale);
+            if (!id)
+            {
+                return std::nullopt;
+            }
+
+            const auto row = table.find(identifier);
+            if (row == translation_table::npos)
+            {
+                return std::nullopt;
+            }
+
+            return table.text(row, *id);
+        }
+
+        /// Identifiers whose probes are prefetched together by a batch lookup
+        constexpr std::size_t batch_block_size = 16;
+    } // namespace
+
+    catalog::catalog(std::shared_ptr<const translation_table> table, bool embedded) : table_(std::move(table)), embedded_(embedded)
+    {
+        auto locales = std::make_shared<std::vector<locale_info>>();
+        locales->reserve(table_->locale_count());
+        for (std::size_t i = 0; i < table_->locale_count(); ++i)
+        {
+            const auto id = static_cast<locale_id>(i);
+            locales->push_back({ table_->locale(id), table_->translated_count(id) });
+        }
+
+        locales_ = std::move(locales);
+    }
+
+    catalog::catalog(std::shared_ptr<locale_cache> cache) : cache_(std::move(cache))
+    {
+    }
+
+    auto catalog::embedded() -> const catalog&
+    {
+        // The embedded tables only view constant data, so every caller shares them
+        static const catalog instance = []() -> catalog
+        {
+            if (const auto locales = get_embedded_locales(); !locales.empty())
+            {
+                std::vector<locale_cache::source> sources;
+                sources.reserve(locales.size());
+                for (const auto& locale : locales)
+                {
+                    sources.push_back({ std::string(locale.locale), {}, locale.data, locale.compressed });
+                }
+
+                return catalog(std::make_shared<locale_cache>(std::move(sources), 0));
+            }
+
+            return catalog(std::make_shared<const translation_table>(get_embedded_translations()), true);
+        }();
+
+        return instance;
+    }
+
+    auto catalog::from_string(std::string_view json_content, std::string& error) -> std::optional<catalog>
+    {
+        // The staged identifiers are released at once with the scratch resource, once the table is built
+        std::pmr::monotonic_buffer_resource scratch;
+        translation_table::builder builder(&scratch);
+        if (!read_json_catalog(json_content, builder, error))
+        {
+            return std::nullopt;
+        }
+
+        return from_builder(builder, error);
+    }
+
+    auto catalog::from_stream(std::istream& input, std::string& error) -> std::optional<catalog>
+    {
+        std::pmr::monotonic_buffer_resource scratch;
+        translation_table::builder builder(&scratch);
+        if (!read_json_catalog(input, builder, error))
+        {
+            return std::nullopt;
+        }
+
+        return from_builder(builder, error);
+    }
+
+    auto catalog::from_file(const std::filesystem::path& path, std::string& error) -> std::optional<catalog>
+    {
+        std::ifstream input(path, std::ios::binary);
+        if (!input.is_open())
+        {
+            error = "cannot open " + path.string();
+            return std::nullopt;
+        }
+
+        return from_stream(input, error);
+    }
+
+    auto catalog::from_mapped(const std::filesystem::path& path, std::string& error) -> std::optional<catalog>
+    {
+        auto mapping = mapped_file::open(path);
+        if (!mapping)
+        {
+            error = "cannot map " + path.string();
+            return std::nullopt;
+        }
+
+        try
+        {
+            auto table = view_mapped_catalog(std::move(*mapping));
+            if (!table || table->empty())
+            {
+                error = "invalid catalog " + path.string();
+                return std::nullopt;
+            }
+
+            return catalog(std::move(table));
+        }
+        catch (const std::exception& exception)
+        {
+            error = exception.what();
+            return std::nullopt;
+        }
+    }
+
+    auto catalog::from_directory(const std::filesystem::path& directory, std::size_t memory_limit, std::string& error)
+        -> std::optional<catalog>
+    {
+        auto sources = locale_cache::scan(directory);
+        if (sources.empty())
+        {
+            error = "no catalogs in " + directory.string();
+            return std::nullopt;
+        }
+
+        return catalog(std::make_shared<locale_cache>(std::move(sources), memory_limit));
+    }
+
+    auto catalog::from_builder(const translation_table::builder& builder, std::string& error) -> std::optional<catalog>
+    {
+        try
+        {
+            auto table = builder.build();
+            if (table.empty())
+            {
+                error = "no translations";
+                return std::nullopt;
+            }
+
+            return catalog(std::make_shared<const translation_table>(std::move(table)));
+        }
+        catch (const std::exception& exception)
+        {
+            error = exception.what();
+            return std::nullopt;
+        }
+    }
+
+    auto catalog::view(std::string_view locale, std::string_view default_locale) const -> locale_view
+    {
+        auto snapshot = resolve(locale, default_locale);
+
+        // Locales used by released views can go once the new chain holds its own
+        trim();
+        return locale_view(std::move(snapshot));
+    }
+
+    auto catalog::get_available_locales() const -> std::vector<std::string>
+    {
+        const auto registry = available_locales();
+
+        std::vector<std::string> locales;
+        locales.reserve(registry.size());
+        for (const auto& locale : registry)
+        {
+            locales.emplace_back(locale.locale);
+        }
+
+        return locales;
+    }
+
+    auto catalog::available_locales() const -> std::span<const locale_info>
+    {
+        // Split locales are counted as they load, so their registry is kept by the cache
+        if (cache_)
+        {
+            return cache_->registry();
+        }
+
+        if (!locales_)
+        {
+            return {};
+        }
+
+        return *locales_;
+    }
+
+    auto catalog::get_loaded_locales() const -> std::vector<std::string>
+    {
+        if (cache_)
+        {
+            return cache_->loaded_locales();
+        }
+
+        return get_available_locales();
+    }
+
+    auto catalog::resolve(std::string_view current_locale, std::string_view default_locale, std::shared_ptr<lookup_statistics> statistics) const
+        -> std::shared_ptr<const translation_snapshot>
+    {
+        auto snapshot = std::make_shared<translation_snapshot>();
+        snapshot->catalog_ = *this;
+        snapshot->locale_ = current_locale;
+        snapshot->plural_rule_ = plural_rule_for(current_locale);
+        snapshot->statistics_ = std::move(statistics);
+        auto& chain = snapshot->chain_;
+
+        if (cache_)
+        {
+            // Materialise the chain's locales, which stay referenced while the snapshot is held
+            const auto locales = collect_locales(*cache_, current_locale, default_locale);
+            for (std::size_t i = 0; i < locales.size; ++i)
+            {
+                auto locale_table = cache_->acquire(locales.values[i]);
+                if (auto id = locale_table ? locale_table->find_locale(cache_->locale(locales.values[i])) : std::nullopt; id)
+                {
+                    snapshot->exact_ = snapshot->exact_ || (i == 0 && locales.exact);
+                    chain.steps[chain.size++] = { std::move(locale_table), *id };
+                }
+            }
+        }
+        else if (table_)
+        {
+            const auto locales = collect_locales(*table_, current_locale, default_locale);
+            snapshot->exact_ = locales.exact;
+            for (std::size_t i = 0; i < locales.size; ++i)
+            {
+                chain.steps[chain.size++] = { table_, static_cast<locale_id>(locales.values[i]) };
+            }
+        }
+
+        return snapshot;
+    }
+
+    void catalog::trim() const
+    {
+        if (cache_)
+        {
+            cache_->trim();
+        }
+    }
+
+    auto translation_snapshot::get_locale() const -> const std::string&
+    {
+        return locale_;
+    }
+
+    auto translation_snapshot::translate_view(std::string_view identifier) const -> std::optional<std::string_view>
+    {
+        auto result = lookup_result::missing;
+#if LINGUIST_STATISTICS
+        if (statistics_)
+        {
+            const auto sample = statistics_->start_sample();
+            const auto text = find(identifier, result);
+            statistics_->record(result, identifier, sample);
+            return text;
+        }
+#endif
+
+        return find(identifier, result);
+    }
+
+    auto translation_snapshot::find(std::string_view identifier, lookup_result& result) const -> std::optional<std::string_view>
+    {
+        const auto hash = hash_identifier(identifier);
+
+        // Consecutive steps usually share a table, which is only searched once
+        const translation_table* table = nullptr;
+        auto row = translation_table::npos;
+        for (std::size_t i = 0; i < chain_.size; ++i)
+        {
+            const auto& step = chain_.steps[i];
+            if (step.table.get() != table)
+            {
+                table = step.table.get();
+                row = table->find(identifier, hash);
+            }
+
+            if (row == translation_table::npos)
+            {
+                continue;
+            }
+
+            if (auto text = table->text(row, step.locale); text)
+            {
+                result = i == 0 && exact_ ? lookup_result::exact : lookup_result::base_language;
+                return text;
+            }
+        }
+
+        // Return first available translation as last resort, unless locales are loaded on demand
+        const auto& all = catalog_.table_;
+        if (!all)
+        {
+            result = lookup_result::missing;
+            return std::nullopt;
+        }
+
+        if (table != all.get())
+        {
+            row = all->find(identifier, hash);
+        }
+
+        const auto text = row == translation_table::npos ? std::nullopt : all->first_text(row);
+        result = text ? lookup_result::any_locale : lookup_result::missing;
+        return text;
+    }
+
+    auto translation_snapshot::translate_view(key_id key) const -> std::optional<std::string_view>
+    {
+        // Keys index the embedded table directly; other tables are searched by name
+        if (catalog_.embedded_ && key.row < catalog_.table_->size())
+        {
+            auto result = lookup_result::missing;
+#if LINGUIST_STATISTICS
+            if (statistics_)
+            {
+                const auto sample = statistics_->start_sample();
+                const auto text = translate_row(key.row, result);
+                statistics_->record(result, key.name, sample);
+                return text;
+            }
+#endif
+
+            return translate_row(key.row, result);
+        }
+
+        return translate_view(key.name);
+    }
+
+    auto translation_snapshot::translate_row(std::uint32_t row, lookup_result& result) const -> std::optional<std::string_view>
+    {
+        for (std::size_t i = 0; i < chain_.size; ++i)
+        {
+            if (auto text = chain_.steps[i].table->text(row, chain_.steps[i].locale); text)
+            {
+                result = i == 0 && exact_ ? lookup_result::exact : lookup_result::base_language;
+                return text;
+            }
+        }
+
+        // Return first available translation as last resort
+        const auto text = catalog_.table_->first_text(row);
+        result = text ? lookup_result::any_locale : lookup_result::missing;
+        return text;
+    }
+
+    auto translation_snapshot::translate_view(std::string_view identifier, std::string_view locale, bool) const
+        -> std::optional<std::string_view>
+    {
+        auto found = find_locale_text(identifier, locale);
+        if (found.table)
+        {
+            pin(std::move(found.table));
+        }
+
+        return found.text;
+    }
+
+    auto translation_snapshot::find_locale_text(std::string_view identifier, std::string_view locale) const -> locale_text
+    {
+        locale_text found;
+        if (const auto& cache = catalog_.cache_; !cache)
+        {
+            found.text = catalog_.table_ ? find_text(*catalog_.table_, identifier, locale) : std::nullopt;
+        }
+        else if (const auto index = cache->find_locale(locale); index)
+        {
+            // The locale is materialised on first use, and cannot be evicted while the caller holds its table
+            found.table = cache->acquire(*index);
+            found.text = found.table ? find_text(*found.table, identifier, locale) : std::nullopt;
+        }
+
+#if LINGUIST_STATISTICS
+        if (statistics_)
+        {
+            statistics_->record(found.text ? lookup_result::exact : lookup_result::missing, identifier);
+        }
+#endif
+
+        return found;
+    }
+
+    void translation_snapshot::pin(std::shared_ptr<const translation_table> table) const
+    {
+        std::lock_guard lock(pinned_mutex_);
+        if (std::find(pinned_.begin(), pinned_.end(), table) == pinned_.end())
+        {
+            pinned_.push_back(std::move(table));
+        }
+    }
+
+    void translation_snapshot::translate_batch(std::span<const std::string_view> identifiers,
+        std::span<std::optional<std::string_view>> translations) const
+    {
+        // Chains over several per-locale tables are looked up one identifier at a time
+        if (!catalog_.table_)
+        {
+            for (std::size_t i = 0; i < identifiers.size(); ++i)
+            {
+                translations[i] = translate_view(identifiers[i]);
+            }
+
+            return;
+        }
+
+        for (std::size_t first = 0; first < identifiers.size(); first += batch_block_size)
+        {
+            const auto count = std::min(batch_block_size, identifiers.size() - first);
+            translate_block(identifiers.subspan(first, count), translations.subspan(first, count));
+        }
+    }
+
+    void translation_snapshot::translate_batch(std::span<const key_id> keys, std::span<std::optional<std::string_view>> translations) const
+    {
+        const auto& table = catalog_.table_;
+        for (std::size_t first = 0; first < keys.size(); first += batch_block_size)
+        {
+            const auto count = std::min(batch_block_size, keys.size() - first);
+            const auto block = keys.subspan(first, count);
+
+            // Keys index the embedded table directly, so only their translations are prefetched
+            if (catalog_.embedded_)
+            {
+                for (const auto& key : block)
+                {
+                    if (key.row < table->size())
+                    {
+                        table->prefetch_row(key.row);
+                    }
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    translations[first + i] = translate_view(block[i]);
+                }
+
+                continue;
+            }
+
+            // Other tables are searched by name
+            std::array<std::string_view, batch_block_size> names;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                names[i] = block[i].name;
+            }
+
+            translate_batch(std::span<const std::string_view>(names.data(), count), translations.subspan(first, count));
+        }
+    }
+
+    void translation_snapshot::translate_block(std::span<const std::string_view> identifiers,
+        std::span<std::optional<std::string_view>> translations) const
+    {
+        const auto& table = *catalog_.table_;
+
+        // Hash the whole block, then issue every index read before waiting on the first
+        std::array<std::uint64_t, batch_block_size> hashes;
+        hash_identifiers(identifiers, hashes);
+        for (std::size_t i = 0; i < identifiers.size(); ++i)
+        {
+            table.prefetch(hashes[i]);
+        }
+
+        // Likewise start loading every row before reading the first translation
+        std::array<std::uint32_t, batch_block_size> rows;
+        for (std::size_t i = 0; i < identifiers.size(); ++i)
+        {
+            rows[i] = table.find(identifiers[i], hashes[i]);
+            if (rows[i] != translation_table::npos)
+            {
+                table.prefetch_row(rows[i]);
+            }
+        }
+
+        for (std::size_t i = 0; i < identifiers.size(); ++i)
+        {
+            auto result = lookup_result::missing;
+            translations[i] = rows[i] == translation_table::npos ? std::nullopt : translate_row(rows[i], result);
+#if LINGUIST_STATISTICS
+            if (statistics_)
+            {
+                statistics_->record(result, identifiers[i]);
+            }
+#endif
+        }
+    }
+
+    auto translation_snapshot::find_message(std::string_view identifier) const -> std::optional<message>
+    {
+        if (auto text = translate_view(identifier); text)
+        {
+            return message_of(*text);
+        }
+
+        return std::nullopt;
+    }
+
+    auto translation_snapshot::find_message(key_id key) const -> std::optional<message>
+    {
+        if (auto text = translate_view(key); text)
+        {
+            return message_of(*text);
+        }
+
+        return std::nullopt;
+    }
+
+    auto translation_snapshot::get_plural_rule() const noexcept -> plural_rule
+    {
+        return plural_rule_;
+    }
+
+    auto translation_snapshot::message_of(std::string_view text) const -> message
+    {
+        // The text was found in one of the chain's tables, or in the whole table as a last resort
+        for (std::size_t i = 0; i < chain_.size; ++i)
+        {
+            if (auto compiled = chain_.steps[i].table->find_message(text); compiled)
+            {
+                return *compiled;
+            }
+        }
+
+        if (const auto& all = catalog_.table_; all)
+        {
+            if (auto compiled = all->find_message(text); compiled)
+            {
+                return *compiled;
+            }
+        }
+
+        return message(text, {});
+    }
+
+    locale_view::locale_view(std::shared_ptr<const translation_snapshot> snapshot) : snapshot_(std::move(snapshot))
+    {
+    }
+
+    auto locale_view::get_locale() const -> const std::string&
+    {
+        return snapshot_->get_locale();
+    }
+
+    auto locale_view::translate(const std::string& identifier) const -> std::optional<std::string>
+    {
+        if (auto translation = snapshot_->translate_view(identifier); translation)
+        {
+            return std::string(*translation);
+        }
+
+        return std::nullopt;
+    }
+
+    auto locale_view::translate(const std::string& identifier, const std::string& fallback) const -> std::string
+    {
+        return std::string(snapshot_->translate_view(identifier).value_or(fallback));
+    }
+
+    auto locale_view::translate_view(std::string_view identifier) const -> std::optional<std::string_view>
+    {
+        return snapshot_->translate_view(identifier);
+    }
+
+    auto locale_view::translate_view(std::string_view identifier, std::string_view fallback) const -> std::string_view
+    {
+        return snapshot_->translate_view(identifier).value_or(fallback);
+    }
+
+    auto locale_view::translate(key_id key) const -> std::optional<std::string>
+    {
+        if (auto translation = snapshot_->translate_view(key); translation)
+        {
+            return std::string(*translation);
+        }
+
+        return std::nullopt;
+    }
+
+    auto locale_view::translate(key_id key, std::string_view fallback) const -> std::string
+    {
+        return std::string(snapshot_->translate_view(key).value_or(fallback));
+    }
+
+    auto locale_view::translate_view(key_id key) const -> std::optional<std::string_view>
+    {
+        return snapshot_->translate_view(key);
+    }
+
+    auto locale_view::translate_view(key_id key, std::string_view fallback) const -> std::string_view
+    {
+        return snapshot_->translate_view(key).value_or(fallback);
+    }
+
+    void locale_view::translate_batch(std::span<const std::string_view> identifiers, std::span<std::optional<std::string_view>> translations) const
+    {
+        snapshot_->translate_batch(identifiers, translations);
+    }
+
+    void locale_view::translate_batch(std::span<const key_id> keys, std::span<std::optional<std::string_view>> translations) const
+    {
+        snapshot_->translate_batch(keys, translations);
+    }
+
+    auto locale_view::format_to(std::string_view identifier, std::span<char> buffer, std::span<const message_argument> arguments) const
+        -> std::optional<std::size_t>
+    {
+        if (auto compiled = snapshot_->find_message(identifier); compiled)
+        {
+            return compiled->format_to(buffer, arguments, snapshot_->get_plural_rule());
+        }
+
+        return std::nullopt;
+    }
+
+    auto locale_view::format_to(key_id key, std::span<char> buffer, std::span<const message_argument> arguments) const
+        -> std::optional<std::size_t>
+    {
+        if (auto compiled = snapshot_->find_message(key); compiled)
+        {
+            return compiled->format_to(buffer, arguments, snapshot_->get_plural_rule());
+        }
+
+        return std::nullopt;
+    }
+
+    auto locale_view::format(std::string_view identifier, std::span<const message_argument> arguments) const -> std::optional<std::string>
+    {
+        if (auto compiled = snapshot_->find_message(identifier); compiled)
+        {
+            return compiled->format(arguments, snapshot_->get_plural_rule());
+        }
+
+        return std::nullopt;
+    }
+
+    auto locale_view::format(key_id key, std::span<const message_argument> arguments) const -> std::optional<std::string>
+    {
+        if (auto compiled = snapshot_->find_message(key); compiled)
+        {
+            return compiled->format(arguments, snapshot_->get_plural_rule());
+        }
+
+        return std::nullopt;
+    }
+
+    auto locale_view::has_translation(std::string_view identifier) const -> bool
+    {
+        return snapshot_->translate_view(identifier).has_value();
+    }
+
+} // namespace linguist
@@ -0,0 +1,430 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include "linguist/key-id.hxx"
+#include "linguist/locale-cache.hxx"
+#include "linguist/lookup-statistics.hxx"
+#include "linguist/message-format.hxx"
+#include "linguist/translation-table.hxx"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace linguist
+{
+    /// Generated function for embedded translations (defined by embed_translation_file)
+    ///
+    /// \return Sections of the embedded translation table, held in constant static storage
+    [[nodiscard]] auto get_embedded_translations() noexcept -> table_data;
+
+    /// Generated function for translations embedded one locale at a time (embed_translation_file SPLIT_LOCALES)
+    ///
+    /// \return Sections of each locale's translation table, or an empty span if the translations are not split
+    [[nodiscard]] auto get_embedded_locales() noexcept -> std::span<const embedded_locale>;
+
+    /// Ordered list of locales probed by a lookup
+    ///
+    /// Resolved once by set_locale() so that lookups only probe a handful of
+    /// locale slots instead of rebuilding and comparing locale strings.
+    ///
+    struct locale_chain
+    {
+        /// Maximum number of steps: exact locale, base language variants and default locale
+        static constexpr std::size_t capacity = 8;
+
+        /// Locale slot of the table holding it
+        struct step
+        {
+            std::shared_ptr<const translation_table> table;
+            locale_id locale{ 0 };
+        };
+
+        std::array<step, capacity> steps{};
+        std::size_t size{ 0 };
+    };
+
+    class translation_snapshot;
+    class locale_view;
+
+    /// Immutable set of translations, shareable between threads
+    ///
+    /// A catalog is a handle to translations that never change once loaded.
+    /// Copies share the same data, so a server loads its translations once and
+    /// every thread or request takes a locale_view of the locale it serves.
+    /// Split per-locale catalogs materialise a locale when a view first needs it.
+    ///
+    class catalog
+    {
+    public:
+        /// Construct a catalog without translations
+        catalog() = default;
+
+        /// Get the translations embedded at build time
+        ///
+        /// The embedded data is referenced in place and shared by every caller.
+        ///
+        /// \return Catalog of the embedded translations
+        [[nodiscard]] static auto embedded() -> const catalog&;
+
+        /// Load translations from a JSON string
+        ///
+        /// \param json_content JSON content as a string
+        /// \param error Receives a description of the error if loading fails
+        /// \return Catalog if loaded successfully
+        [[nodiscard]] static auto from_string(std::string_view json_content, std::string& error) -> std::optional<catalog>;
+
+        /// Load translations from a JSON stream
+        ///
+        /// \param input Stream holding the JSON content
+        /// \param error Receives a description of the error if loading fails
+        /// \return Catalog if loaded successfully
+        [[nodiscard]] static auto from_stream(std::istream& input, std::string& error) -> std::optional<catalog>;
+
+        /// Load translations from a JSON file
+        ///
+        /// \param path Path of the JSON file
+        /// \param error Receives a description of the error if loading fails
+        /// \return Catalog if loaded successfully
+        [[nodiscard]] static auto from_file(const std::filesystem::path& path, std::string& error) -> std::optional<catalog>;
+
+        /// Load translations from a memory-mapped binary catalog
+        ///
+        /// \param path Path of the catalog file written by linguist-embed-tool --binary
+        /// \param error Receives a description of the error if loading fails
+        /// \return Catalog if loaded successfully
+        [[nodiscard]] static auto from_mapped(const std::filesystem::path& path, std::string& error) -> std::optional<catalog>;
+
+        /// Load translations split into one catalog per locale
+        ///
+        /// \param directory Directory holding the per-locale catalogs
+        /// \param memory_limit Bytes of loaded catalogs to keep, or 0 for no limit
+        /// \param error Receives a description of the error if loading fails
+        /// \return Catalog if the directory holds at least one catalog
+        [[nodiscard]] static auto from_directory(const std::filesystem::path& directory, std::size_t memory_limit, std::string& error)
+            -> std::optional<catalog>;
+
+        /// Bind the translations to a locale
+        ///
+        /// Resolves the fallback chain once, so that lookups through the view only
+        /// probe its locales. With a memory limit, locales that no view uses any
+        /// more are evicted.
+        ///
+        /// \param locale Locale code (e.g., "en-US", "fr-FR")
+        /// \param default_locale Locale tried after the locale and its base language, or an empty string for none
+        /// \return View of the translations for the locale
+        [[nodiscard]] auto view(std::string_view locale, std::string_view default_locale = {}) const -> locale_view;
+
+        /// Get all available locales
+        ///
+        /// \return List of locale codes
+        [[nodiscard]] auto get_available_locales() const -> std::vector<std::string>;
+
+        /// Get the registry of available locales
+        ///
+        /// The counts are stored by built tables and binary catalogs, so the
+        /// registry is built without scanning the translations, and reading it
+        /// does not allocate. Split locales of compressed or JSON catalogs have
+        /// an unknown count until they are first loaded; the registry returned
+        /// after that, which is allocated once, includes it.
+        ///
+        /// \return Each locale and its coverage, in the order of get_available_locales(), valid as long as any copy of the catalog
+        [[nodiscard]] auto available_locales() const -> std::span<const locale_info>;
+
+        /// Get the locales whose translations are currently loaded
+        ///
+        /// \return List of locale codes, which is every available locale unless translations are split per locale
+        [[nodiscard]] auto get_loaded_locales() const -> std::vector<std::string>;
+
+    private:
+        friend class translation_snapshot;
+        friend class translator;
+
+        /// Construct a catalog of a table holding every locale
+        explicit catalog(std::shared_ptr<const translation_table> table, bool embedded = false);
+
+        /// Construct a catalog of translations split per locale
+        explicit catalog(std::shared_ptr<locale_cache> cache);
+
+        /// Build a catalog from the translations read by a loader
+        [[nodiscard]] static auto from_builder(const translation_table::builder& builder, std::string& error) -> std::optional<catalog>;
+
+        /// Resolve the fallback chain of a locale into a new snapshot
+        ///
+        /// \param current_locale Locale to translate into
+        /// \param default_locale Locale to fall back to
+        /// \param statistics Statistics counting the snapshot's lookups, if any
+        [[nodiscard]] auto resolve(std::string_view current_locale, std::string_view default_locale,
+            std::shared_ptr<lookup_statistics> statistics = {}) const -> std::shared_ptr<const translation_snapshot>;
+
+        /// Evict the locales that no snapshot uses any more, if translations are split per locale
+        void trim() const;
+
+    private:
+        std::shared_ptr<const translation_table> table_;
+        std::shared_ptr<locale_cache> cache_;
+        std::shared_ptr<const std::vector<locale_info>> locales_;
+        bool embedded_{ false };
+    };
+
+    /// Immutable translations and resolved locale chain
+    ///
+    /// A translator publishes a new snapshot whenever translations are loaded
+    /// or a locale changes, and each locale_view holds one. A snapshot keeps its
+    /// tables alive, so the views it returns stay valid while it is held,
+    /// however often the translator is reloaded meanwhile.
+    ///
+    class translation_snapshot
+    {
+    public:
+        /// Get the locale the snapshot's fallback chain was resolved for
+        ///
+        /// \return Locale code
+        [[nodiscard]] auto get_locale() const -> const std::string&;
+
+        /// Get a view of the translation for an identifier using the snapshot's locale chain
+        ///
+        /// \param identifier Translation identifier/key
+        /// \return View of the translated string if found
+        [[nodiscard]] auto translate_view(std::string_view identifier) const -> std::optional<std::string_view>;
+
+        /// Get a view of the translation for a compile-time key using the snapshot's locale chain
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \return View of the translated string if found
+        [[nodiscard]] auto translate_view(key_id key) const -> std::optional<std::string_view>;
+
+        /// Get a view of the translation for a specific locale
+        ///
+        /// A split locale is loaded on first use, and the snapshot keeps it loaded
+        /// until the snapshot is released, so that the view stays valid while the
+        /// snapshot is held. Lookups that need not keep the locale loaded, such as
+        /// a server cycling through many locales under a memory limit, should
+        /// copy the translation with translator::translate() instead.
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param locale Locale code to use for this translation
+        /// \return View of the translated string if found
+        [[nodiscard]] auto translate_view(std::string_view identifier, std::string_view locale, bool) const -> std::optional<std::string_view>;
+
+        /// Get views of the translations of several identifiers using the snapshot's locale chain
+        ///
+        /// The identifiers are hashed together, and their index and translation
+        /// reads are prefetched a block at a time so that their cache misses overlap.
+        ///
+        /// \param identifiers Translation identifiers/keys
+        /// \param translations Receives the view of each identifier's translation if found, and must be at least as large as identifiers
+        void translate_batch(std::span<const std::string_view> identifiers, std::span<std::optional<std::string_view>> translations) const;
+
+        /// Get views of the translations of several compile-time keys using the snapshot's locale chain
+        ///
+        /// \param keys Key handles generated from the embedded translations
+        /// \param translations Receives the view of each key's translation if found, and must be at least as large as keys
+        void translate_batch(std::span<const key_id> keys, std::span<std::optional<std::string_view>> translations) const;
+
+        /// Get the precompiled message of an identifier using the snapshot's locale chain
+        ///
+        /// \param identifier Translation identifier/key
+        /// \return Message of the translation if found, valid as long as the snapshot
+        [[nodiscard]] auto find_message(std::string_view identifier) const -> std::optional<message>;
+
+        /// Get the precompiled message of a compile-time key using the snapshot's locale chain
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \return Message of the translation if found, valid as long as the snapshot
+        [[nodiscard]] auto find_message(key_id key) const -> std::optional<message>;
+
+        /// Get the plural rule of the snapshot's locale
+        ///
+        /// \return Plural rule used to format messages
+        [[nodiscard]] auto get_plural_rule() const noexcept -> plural_rule;
+
+    private:
+        friend class catalog;
+        friend class translator;
+
+        /// Get the translation of an identifier following the locale chain, and how it was found
+        [[nodiscard]] auto find(std::string_view identifier, lookup_result& result) const -> std::optional<std::string_view>;
+
+        /// Translation of an identifier in one locale, with the split locale's table that holds it
+        struct locale_text
+        {
+            std::optional<std::string_view> text;
+            std::shared_ptr<const translation_table> table;
+        };
+
+        /// Get the translation of an identifier in one locale, counting the lookup
+        [[nodiscard]] auto find_locale_text(std::string_view identifier, std::string_view locale) const -> locale_text;
+
+        /// Keep a split locale's table loaded while the snapshot is held
+        void pin(std::shared_ptr<const translation_table> table) const;
+
+        /// Get the translation of a table row following the locale chain, and how it was found
+        [[nodiscard]] auto translate_row(std::uint32_t row, lookup_result& result) const -> std::optional<std::string_view>;
+
+        /// Translate one block of identifiers of a batch served by a single table
+        void translate_block(std::span<const std::string_view> identifiers, std::span<std::optional<std::string_view>> translations) const;
+
+        /// Get the precompiled message of a translation found through the locale chain
+        [[nodiscard]] auto message_of(std::string_view text) const -> message;
+
+    private:
+        catalog catalog_;
+        std::string locale_;
+        locale_chain chain_;
+        plural_rule plural_rule_{ nullptr };
+
+        /// Whether the chain starts with the snapshot's own locale, rather than a fallback
+        bool exact_{ false };
+
+        /// Statistics counting lookups, or nullptr when they are not collected
+        std::shared_ptr<lookup_statistics> statistics_;
+
+        /// Tables of split locales looked up explicitly
+        mutable std::mutex pinned_mutex_;
+        mutable std::vector<std::shared_ptr<const translation_table>> pinned_;
+    };
+
+    /// Translations of a catalog bound to one locale
+    ///
+    /// A view never changes and is cheap to copy, so threads serving different
+    /// locales each hold their own without locking while sharing one copy of the
+    /// catalog. The views it returns stay valid as long as any copy is held.
+    ///
+    class locale_view
+    {
+    public:
+        /// Get the locale of the view
+        ///
+        /// \return Locale code
+        [[nodiscard]] auto get_locale() const -> const std::string&;
+
+        /// Get translation for an identifier
+        ///
+        /// \param identifier Translation identifier/key
+        /// \return Translated string if found
+        [[nodiscard]] auto translate(const std::string& identifier) const -> std::optional<std::string>;
+
+        /// Get translation for an identifier with fallback
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param fallback Fallback string if translation not found
+        /// \return Translated string or fallback
+        [[nodiscard]] auto translate(const std::string& identifier, const std::string& fallback) const -> std::string;
+
+        /// Get a view of the translation for an identifier
+        ///
+        /// \param identifier Translation identifier/key
+        /// \return View of the translated string if found
+        [[nodiscard]] auto translate_view(std::string_view identifier) const -> std::optional<std::string_view>;
+
+        /// Get a view of the translation for an identifier with fallback
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param fallback Fallback string if translation not found
+        /// \return View of the translated string or fallback
+        [[nodiscard]] auto translate_view(std::string_view identifier, std::string_view fallback) const -> std::string_view;
+
+        /// Get translation for a compile-time key
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \return Translated string if found
+        [[nodiscard]] auto translate(key_id key) const -> std::optional<std::string>;
+
+        /// Get translation for a compile-time key with fallback
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \param fallback Fallback string if translation not found
+        /// \return Translated string or fallback
+        [[nodiscard]] auto translate(key_id key, std::string_view fallback) const -> std::string;
+
+        /// Get a view of the translation for a compile-time key
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \return View of the translated string if found
+        [[nodiscard]] auto translate_view(key_id key) const -> std::optional<std::string_view>;
+
+        /// Get a view of the translation for a compile-time key with fallback
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \param fallback Fallback string if translation not found
+        /// \return View of the translated string or fallback
+        [[nodiscard]] auto translate_view(key_id key, std::string_view fallback) const -> std::string_view;
+
+        /// Get views of the translations of several identifiers
+        ///
+        /// \param identifiers Translation identifiers/keys
+        /// \param translations Receives the view of each identifier's translation if found, and must be at least as large as identifiers
+        void translate_batch(std::span<const std::string_view> identifiers, std::span<std::optional<std::string_view>> translations) const;
+
+        /// Get views of the translations of several compile-time keys
+        ///
+        /// \param keys Key handles generated from the embedded translations
+        /// \param translations Receives the view of each key's translation if found, and must be at least as large as keys
+        void translate_batch(std::span<const key_id> keys, std::span<std::optional<std::string_view>> translations) const;
+
+        /// Format the message of an identifier into a buffer
+        ///
+        /// The message was compiled when the translations were loaded or embedded,
+        /// so formatting neither parses it nor allocates.
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param buffer Receives the formatted message, truncated if it does not fit
+        /// \param arguments Arguments of the message's placeholders
+        /// \return Size of the whole formatted message if found, which is larger than buffer if it was truncated
+        [[nodiscard]] auto format_to(std::string_view identifier, std::span<char> buffer, std::span<const message_argument> arguments) const
+            -> std::optional<std::size_t>;
+
+        /// Format the message of a compile-time key into a buffer
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \param buffer Receives the formatted message, truncated if it does not fit
+        /// \param arguments Arguments of the message's placeholders
+        /// \return Size of the whole formatted message if found, which is larger than buffer if it was truncated
+        [[nodiscard]] auto format_to(key_id key, std::span<char> buffer, std::span<const message_argument> arguments) const
+            -> std::optional<std::size_t>;
+
+        /// Format the message of an identifier
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param arguments Arguments of the message's placeholders
+        /// \return Formatted message if found
+        [[nodiscard]] auto format(std::string_view identifier, std::span<const message_argument> arguments) const -> std::optional<std::string>;
+
+        /// Format the message of a compile-time key
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \param arguments Arguments of the message's placeholders
+        /// \return Formatted message if found
+        [[nodiscard]] auto format(key_id key, std::span<const message_argument> arguments) const -> std::optional<std::string>;
+
+        /// Check if a translation exists for an identifier
+        ///
+        /// \param identifier Translation identifier/key
+        /// \return true if translation exists for the view's locale
+        /// \return false otherwise
+        [[nodiscard]] auto has_translation(std::string_view identifier) const -> bool;
+
+    private:
+        friend class catalog;
+
+        /// Construct a view of a resolved snapshot
+        explicit locale_view(std::shared_ptr<const translation_snapshot> snapshot);
+
+    private:
+        std::shared_ptr<const translation_snapshot> snapshot_;
+    };
+
+} // namespace linguist
@@ -0,0 +1,213 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/compression.hxx"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace linguist
+{
+    namespace
+    {
+        /// Shortest match worth a reference
+        constexpr std::size_t min_match = 4;
+
+        /// Farthest match a 16-bit offset can reach
+        constexpr std::size_t max_offset = 0xFFFF;
+
+        /// Bits of the match finder's hash table
+        constexpr unsigned hash_bits = 16;
+
+        /// Largest value of a token's length nibble; larger lengths continue in extra bytes
+        constexpr std::size_t nibble_limit = 15;
+
+        /// Read four bytes for the match finder
+        auto load32(const char* data) noexcept -> std::uint32_t
+        {
+            std::uint32_t value{};
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        /// Hash four bytes into the match finder's table
+        auto hash32(std::uint32_t value) noexcept -> std::uint32_t
+        {
+            return (value * 2654435761u) >> (32 - hash_bits);
+        }
+
+        /// Append the part of a length that does not fit in its token nibble
+        void write_length(std::string& output, std::size_t length)
+        {
+            for (length -= nibble_limit; length >= 0xFF; length -= 0xFF)
+            {
+                output += static_cast<char>(0xFF);
+            }
+            output += static_cast<char>(length);
+        }
+
+        /// Append a sequence of literals followed by a match, or by nothing at the end of the input
+        void write_sequence(std::string& output, std::span<const char> literals, std::size_t offset, std::size_t match)
+        {
+            const auto match_code = match == 0 ? 0 : match - min_match;
+            output += static_cast<char>((std::min(literals.size(), nibble_limit) << 4) | std::min(match_code, nibble_limit));
+            if (literals.size() >= nibble_limit)
+            {
+                write_length(output, literals.size());
+            }
+
+            output.append(literals.data(), literals.size());
+            if (match == 0)
+            {
+                return;
+            }
+
+            output += static_cast<char>(offset & 0xFF);
+            output += static_cast<char>(offset >> 8);
+            if (match_code >= nibble_limit)
+            {
+                write_length(output, match_code);
+            }
+        }
+
+        /// Read the part of a length that did not fit in its token nibble
+        auto read_length(const unsigned char*& input, const unsigned char* end, std::size_t& length) noexcept -> bool
+        {
+            if (length != nibble_limit)
+            {
+                return true;
+            }
+
+            while (input != end)
+            {
+                const auto byte = *input++;
+                length += byte;
+                if (byte != 0xFF)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    } // namespace
+
+    auto compress(std::span<const char> input) -> std::string
+    {
+        std::string output;
+        output.reserve(input.size() / 2 + 16);
+
+        // Position + 1 of the last occurrence of each hashed 4-byte sequence
+        std::vector<std::uint32_t> last(std::size_t{ 1 } << hash_bits);
+
+        std::size_t anchor = 0;
+        std::size_t position = 0;
+        while (position + min_match <= input.size())
+        {
+            const auto value = load32(input.data() + position);
+            auto& slot = last[hash32(value)];
+            const std::size_t candidate = slot;
+            slot = static_cast<std::uint32_t>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > max_offset || load32(input.data() + candidate - 1) != value)
+            {
+                ++position;
+                continue;
+            }
+
+            // Extend the match as far as it goes
+            const auto source = candidate - 1;
+            auto match = min_match;
+            while (position + match < input.size() && input[source + match] == input[position + match])
+            {
+                ++match;
+            }
+
+            write_sequence(output, input.subspan(anchor, position - anchor), position - source, match);
+            position += match;
+            anchor = position;
+
+            // Index the end of the match so that the next one can continue from it
+            if (position >= 2 && position + 2 <= input.size())
+            {
+                last[hash32(load32(input.data() + position - 2))] = static_cast<std::uint32_t>(position - 1);
+            }
+        }
+
+        write_sequence(output, input.subspan(anchor), 0, 0);
+        return output;
+    }
+
+    auto decompress(std::span<const char> input, std::span<char> output) noexcept -> bool
+    {
+        auto in = reinterpret_cast<const unsigned char*>(input.data());
+        const auto in_end = in + input.size();
+        auto out = output.data();
+        const auto out_end = out + output.size();
+
+        // Every stream ends with a sequence of literals alone, so that truncation is detected
+        while (in != in_end)
+        {
+            const auto token = *in++;
+
+            // Copy the literals
+            std::size_t literals = token >> 4;
+            if (!read_length(in, in_end, literals) || literals > static_cast<std::size_t>(in_end - in) ||
+                literals > static_cast<std::size_t>(out_end - out))
+            {
+                return false;
+            }
+
+            std::memcpy(out, in, literals);
+            in += literals;
+            out += literals;
+
+            // The last sequence has no match
+            if (in == in_end)
+            {
+                return out == out_end;
+            }
+
+            if (in_end - in < 2)
+            {
+                return false;
+            }
+
+            const std::size_t offset = in[0] | (static_cast<std::size_t>(in[1]) << 8);
+            in += 2;
+
+            std::size_t match = token & 0x0F;
+            if (!read_length(in, in_end, match))
+            {
+                return false;
+            }
+
+            match += min_match;
+            if (offset == 0 || offset > static_cast<std::size_t>(out - output.data()) || match > static_cast<std::size_t>(out_end - out))
+            {
+                return false;
+            }
+
+            // Matches may overlap the bytes they produce, repeating a short run
+            const auto* source = out - offset;
+            if (offset >= match)
+            {
+                std::memcpy(out, source, match);
+                out += match;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < match; ++i)
+                {
+                    *out++ = source[i];
+                }
+            }
+        }
+
+        return false;
+    }
+
+} // namespace linguist
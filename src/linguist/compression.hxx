@@ -0,0 +1,39 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace linguist
+{
+    /// Most bytes one compressed byte can decompress to
+    ///
+    /// A match's length continues in extra bytes of up to 255 each, so no
+    /// valid input expands further than this.
+    inline constexpr std::size_t max_expansion = 255;
+
+    /// Compress bytes with a byte-oriented LZ77 codec
+    ///
+    /// Repeated substrings within the previous 64 KiB are replaced by
+    /// references to them, so that a catalog's identifiers and recurring words
+    /// act as a dictionary for the rest of it. The format follows LZ4's block
+    /// layout: each sequence is a token holding the literal and match lengths,
+    /// the literals, and a 16-bit offset of the match.
+    ///
+    /// \param input Bytes to compress
+    /// \return Compressed bytes
+    [[nodiscard]] auto compress(std::span<const char> input) -> std::string;
+
+    /// Decompress bytes written by compress()
+    ///
+    /// \param input Compressed bytes
+    /// \param output Receives the decompressed bytes, and must be exactly their size
+    /// \return true if the input decompressed to exactly output.size() bytes
+    /// \return false if the input is malformed or of a different size
+    [[nodiscard]] auto decompress(std::span<const char> input, std::span<char> output) noexcept -> bool;
+
+} // namespace linguist
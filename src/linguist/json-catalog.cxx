@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/json-catalog.hxx"
+
+#include <exception>
+#include <nlohmann/json.hpp>
+
+namespace linguist
+{
+    namespace
+    {
+        /// SAX handler adding translations to a builder as they are parsed
+        class catalog_handler final : public nlohmann::json_sax<nlohmann::json>
+        {
+        public:
+            catalog_handler(translation_table::builder& builder, std::string& error) : builder_(builder), error_(error)
+            {
+            }
+
+            auto null() -> bool override
+            {
+                return unexpected("null");
+            }
+
+            auto boolean(bool) -> bool override
+            {
+                return unexpected("boolean");
+            }
+
+            auto number_integer(number_integer_t) -> bool override
+            {
+                return unexpected("number");
+            }
+
+            auto number_unsigned(number_unsigned_t) -> bool override
+            {
+                return unexpected("number");
+            }
+
+            auto number_float(number_float_t, const string_t&) -> bool override
+            {
+                return unexpected("number");
+            }
+
+            auto string(string_t& value) -> bool override
+            {
+                if (depth_ != 2)
+                {
+                    return unexpected("string");
+                }
+
+                builder_.add(identifier_, locale_, value);
+                return true;
+            }
+
+            auto binary(binary_t&) -> bool override
+            {
+                return unexpected("binary value");
+            }
+
+            auto start_object(std::size_t) -> bool override
+            {
+                if (depth_ == 2)
+                {
+                    return unexpected("object");
+                }
+
+                ++depth_;
+                return true;
+            }
+
+            auto key(string_t& value) -> bool override
+            {
+                // Reuse the capacity of the previous key
+                (depth_ == 1 ? identifier_ : locale_).assign(value);
+                return true;
+            }
+
+            auto end_object() -> bool override
+            {
+                --depth_;
+                return true;
+            }
+
+            auto start_array(std::size_t) -> bool override
+            {
+                return unexpected("array");
+            }
+
+            auto end_array() -> bool override
+            {
+                return false;
+            }
+
+            auto parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& exception) -> bool override
+            {
+                error_ = exception.what();
+                return false;
+            }
+
+        private:
+            auto unexpected(std::string_view kind) -> bool
+            {
+                error_ = "unexpected " + std::string(kind);
+                if (!identifier_.empty())
+                {
+                    error_ += " in \"" + identifier_ + "\"";
+                }
+
+                return false;
+            }
+
+        private:
+            translation_table::builder& builder_;
+            std::string& error_;
+            std::string identifier_;
+            std::string locale_;
+            std::size_t depth_{ 0 };
+        };
+
+        template <typename Input>
+        auto read(Input&& input, translation_table::builder& builder, std::string& error) -> bool
+        {
+            try
+            {
+                catalog_handler handler(builder, error);
+                return nlohmann::json::sax_parse(std::forward<Input>(input), &handler);
+            }
+            catch (const std::exception& exception)
+            {
+                error = exception.what();
+                return false;
+            }
+        }
+    } // namespace
+
+    auto read_json_catalog(std::string_view json, translation_table::builder& builder, std::string& error) -> bool
+    {
+        return read(json, builder, error);
+    }
+
+    auto read_json_catalog(std::istream& input, translation_table::builder& builder, std::string& error) -> bool
+    {
+        return read(input, builder, error);
+    }
+
+} // namespace linguist
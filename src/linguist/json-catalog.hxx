@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include "linguist/translation-table.hxx"
+
+#include <istream>
+#include <string>
+#include <string_view>
+
+namespace linguist
+{
+    /// Read a JSON catalog into a table builder
+    ///
+    /// The catalog is parsed as a stream of SAX events and each translation is
+    /// added to the builder as soon as it is read, without building a JSON
+    /// document. The catalog must be an object of identifiers, each mapping
+    /// locale codes to translated strings.
+    ///
+    /// \param json JSON catalog
+    /// \param builder Builder receiving the translations
+    /// \param error Receives a description of the first error
+    /// \return true if the whole catalog was read
+    /// \return false if the catalog is malformed; the builder may hold part of it
+    [[nodiscard]] auto read_json_catalog(std::string_view json, translation_table::builder& builder, std::string& error) -> bool;
+
+    /// Read a JSON catalog from a stream into a table builder
+    ///
+    /// \param input Stream holding the JSON catalog
+    /// \param builder Builder receiving the translations
+    /// \param error Receives a description of the first error
+    /// \return true if the whole catalog was read
+    /// \return false if the catalog is malformed; the builder may hold part of it
+    [[nodiscard]] auto read_json_catalog(std::istream& input, translation_table::builder& builder, std::string& error) -> bool;
+
+} // namespace linguist
@@ -0,0 +1,28 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace linguist
+{
+    /// Compile-time handle of a translation identifier
+    ///
+    /// Handles are generated by embed_translation_file(... KEYS_HEADER ...) as
+    /// constants in the linguist::keys namespace, so a misspelled identifier is a
+    /// compile error. While the embedded translations are active, a handle indexes
+    /// the table directly; after load_from_string() it is looked up by name.
+    ///
+    struct key_id
+    {
+        /// Row of the identifier in the embedded translation table
+        std::uint32_t row;
+
+        /// Translation identifier/key
+        std::string_view name;
+    };
+
+} // namespace linguist
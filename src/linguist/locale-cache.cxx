@@ -0,0 +1,361 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/locale-cache.hxx"
+#include "linguist/json-catalog.hxx"
+#include "linguist/translation-catalog.hxx"
+
+#include <exception>
+#include <fstream>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+namespace linguist
+{
+    namespace
+    {
+        /// Table viewing a mapped binary catalog, which it keeps mapped
+        struct mapped_table
+        {
+            mapped_file mapping;
+            translation_table table;
+        };
+
+        /// Table viewing a decompressed binary catalog, which it owns
+        struct decompressed_table
+        {
+            std::vector<std::uint64_t> storage;
+            translation_table table;
+        };
+    } // namespace
+
+    auto view_mapped_catalog(mapped_file mapping) -> std::shared_ptr<const translation_table>
+    {
+        if (compressed_catalog_size(mapping.data()))
+        {
+            return view_compressed_catalog(mapping.data());
+        }
+
+        const auto data = read_catalog(mapping.data());
+        if (!data)
+        {
+            return nullptr;
+        }
+
+        // The table views the mapped pages, which stay at the same address when moved
+        auto holder = std::make_shared<mapped_table>(mapped_table{ std::move(mapping), translation_table(*data) });
+        return std::shared_ptr<const translation_table>(holder, &holder->table);
+    }
+
+    auto view_compressed_catalog(std::span<const char> catalog) -> std::shared_ptr<const translation_table>
+    {
+        const auto size = compressed_catalog_size(catalog);
+        if (!size)
+        {
+            return nullptr;
+        }
+
+        // Words keep the catalog's sections aligned
+        auto holder = std::make_shared<decompressed_table>();
+        holder->storage.resize((*size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+        const std::span<char> bytes(reinterpret_cast<char*>(holder->storage.data()), *size);
+        if (!decompress_catalog(catalog, bytes))
+        {
+            return nullptr;
+        }
+
+        const auto data = read_catalog(bytes);
+        if (!data)
+        {
+            return nullptr;
+        }
+
+        holder->table = translation_table(*data);
+        return std::shared_ptr<const translation_table>(holder, &holder->table);
+    }
+
+    locale_cache::locale_cache(std::vector<source> sources, std::size_t memory_limit)
+        : sources_(std::move(sources)), memory_limit_(memory_limit), entries_(sources_.size())
+    {
+        for (std::size_t i = 0; i < sources_.size(); ++i)
+        {
+            entries_[i].translated.store(stored_count(sources_[i]), std::memory_order_relaxed);
+        }
+    }
+
+    auto locale_cache::scan(const std::filesystem::path& directory) -> std::vector<source>
+    {
+        std::map<std::string, std::filesystem::path, std::less<>> catalogs;
+
+        std::error_code error;
+        for (const auto& file : std::filesystem::directory_iterator(directory, error))
+        {
+            const auto extension = file.path().extension();
+            if (!file.is_regular_file(error) || (extension != ".lcat" && extension != ".json"))
+            {
+                continue;
+            }
+
+            auto [it, inserted] = catalogs.try_emplace(file.path().stem().string(), file.path());
+            if (!inserted && extension == ".lcat")
+            {
+                it->second = file.path();
+            }
+        }
+
+        std::vector<source> sources;
+        sources.reserve(catalogs.size());
+        for (auto& [locale, path] : catalogs)
+        {
+            sources.push_back({ locale, std::move(path), {}, {} });
+        }
+
+        return sources;
+    }
+
+    auto locale_cache::locale_count() const noexcept -> std::size_t
+    {
+        return sources_.size();
+    }
+
+    auto locale_cache::locale(std::size_t locale) const noexcept -> std::string_view
+    {
+        return sources_[locale].locale;
+    }
+
+    auto locale_cache::translated_count(std::size_t locale) const noexcept -> std::optional<std::size_t>
+    {
+        if (const auto count = entries_[locale].translated.load(std::memory_order_acquire); count != locale_info::unknown)
+        {
+            return count;
+        }
+
+        return std::nullopt;
+    }
+
+    auto locale_cache::registry() const -> std::span<const locale_info>
+    {
+        const auto counted = counted_.load(std::memory_order_acquire);
+        if (const auto* current = registry_.load(std::memory_order_acquire); current && current->counted >= counted)
+        {
+            return current->locales;
+        }
+
+        // Only the first call after a locale is counted builds a registry
+        std::lock_guard lock(registry_mutex_);
+        if (const auto* current = registry_.load(std::memory_order_relaxed); current && current->counted >= counted)
+        {
+            return current->locales;
+        }
+
+        auto version = std::make_unique<registry_version>();
+        version->counted = counted;
+        version->locales.reserve(sources_.size());
+        for (std::size_t i = 0; i < sources_.size(); ++i)
+        {
+            version->locales.push_back({ sources_[i].locale, entries_[i].translated.load(std::memory_order_acquire) });
+        }
+
+        registry_.store(version.get(), std::memory_order_release);
+        registries_.push_back(std::move(version));
+        return registries_.back()->locales;
+    }
+
+    auto locale_cache::find_locale(std::string_view locale) const noexcept -> std::optional<std::size_t>
+    {
+        for (std::size_t i = 0; i < sources_.size(); ++i)
+        {
+            if (sources_[i].locale == locale)
+            {
+                return i;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    auto locale_cache::acquire(std::size_t locale) const -> std::shared_ptr<const translation_table>
+    {
+        auto& entry = entries_[locale];
+        entry.last_used.store(clock_.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (auto table = entry.table.load(); table || entry.failed.load(std::memory_order_acquire))
+        {
+            return table;
+        }
+
+        // Only threads needing this locale wait for it to load
+        std::lock_guard load_lock(entry.load_mutex);
+        if (auto table = entry.table.load(); table || entry.failed.load(std::memory_order_acquire))
+        {
+            return table;
+        }
+
+        auto loaded = materialise(sources_[locale]);
+        if (!loaded.table)
+        {
+            entry.failed.store(true, std::memory_order_release);
+            return nullptr;
+        }
+
+        {
+            // Locales looked up once are released as others load, while the table returned here stays referenced
+            std::lock_guard lock(mutex_);
+            entry.bytes = loaded.bytes;
+            memory_usage_ += loaded.bytes;
+            evict();
+        }
+
+        // Compressed and JSON catalogs are only counted once loaded
+        if (entry.translated.load(std::memory_order_relaxed) == locale_info::unknown)
+        {
+            const auto id = loaded.table->find_locale(sources_[locale].locale);
+            entry.translated.store(id ? loaded.table->translated_count(*id) : 0, std::memory_order_release);
+            counted_.fetch_add(1, std::memory_order_release);
+        }
+
+        entry.table.store(loaded.table);
+        return std::move(loaded.table);
+    }
+
+    void locale_cache::trim()
+    {
+        std::lock_guard lock(mutex_);
+        evict();
+    }
+
+    void locale_cache::evict() const
+    {
+        while (memory_limit_ != 0 && memory_usage_ > memory_limit_)
+        {
+            // Only tables referenced by nobody else (but the entry and this copy) can be released
+            entry* victim = nullptr;
+            for (auto& entry : entries_)
+            {
+                if (const auto table = entry.table.load(); table && entry.bytes != 0 && table.use_count() == 2 &&
+                    (!victim || entry.last_used.load(std::memory_order_relaxed) < victim->last_used.load(std::memory_order_relaxed)))
+                {
+                    victim = &entry;
+                }
+            }
+
+            if (!victim)
+            {
+                break;
+            }
+
+            memory_usage_ -= victim->bytes;
+            victim->bytes = 0;
+            victim->table.store(nullptr);
+        }
+    }
+
+    auto locale_cache::loaded_locales() const -> std::vector<std::string>
+    {
+        std::vector<std::string> locales;
+        for (std::size_t i = 0; i < entries_.size(); ++i)
+        {
+            if (entries_[i].table.load())
+            {
+                locales.push_back(sources_[i].locale);
+            }
+        }
+
+        return locales;
+    }
+
+    auto locale_cache::memory_usage() const -> std::size_t
+    {
+        std::lock_guard lock(mutex_);
+        return memory_usage_;
+    }
+
+    auto locale_cache::stored_count(const source& source) -> std::size_t
+    {
+        if (source.path.empty())
+        {
+            if (!source.compressed.empty())
+            {
+                return locale_info::unknown;
+            }
+
+            const translation_table table(source.data);
+            const auto id = table.find_locale(source.locale);
+            return id ? table.translated_count(*id) : 0;
+        }
+
+        // Binary catalogs are mapped, but only their header, locale codes and counts are read
+        if (source.path.extension() != ".lcat")
+        {
+            return locale_info::unknown;
+        }
+
+        const auto mapping = mapped_file::open(source.path);
+        if (!mapping)
+        {
+            return locale_info::unknown;
+        }
+
+        return catalog_translated_count(mapping->data(), source.locale).value_or(locale_info::unknown);
+    }
+
+    auto locale_cache::materialise(const source& source) const -> materialised
+    {
+        // A corrupt catalog, or one too large to hold, fails its locale rather than the lookup
+        try
+        {
+            // Embedded sections are viewed in place, and embedded compressed catalogs decompressed
+            if (source.path.empty() && !source.compressed.empty())
+            {
+                if (auto table = view_compressed_catalog(source.compressed); table)
+                {
+                    return { std::move(table), *compressed_catalog_size(source.compressed) };
+                }
+
+                return {};
+            }
+
+            if (source.path.empty())
+            {
+                return { std::make_shared<const translation_table>(source.data), 0 };
+            }
+
+            // Binary catalogs are mapped and viewed in place, or decompressed
+            if (source.path.extension() == ".lcat")
+            {
+                auto mapping = mapped_file::open(source.path);
+                if (!mapping)
+                {
+                    return {};
+                }
+
+                const auto bytes = compressed_catalog_size(mapping->data()).value_or(mapping->data().size());
+                if (auto table = view_mapped_catalog(std::move(*mapping)); table)
+                {
+                    return { std::move(table), bytes };
+                }
+
+                return {};
+            }
+
+            // JSON catalogs are parsed into a table of their own
+            std::ifstream input(source.path, std::ios::binary);
+            std::pmr::monotonic_buffer_resource scratch;
+            translation_table::builder builder(&scratch);
+            if (std::string error; !input.is_open() || !read_json_catalog(input, builder, error))
+            {
+                return {};
+            }
+
+            auto table = std::make_shared<const translation_table>(builder.build());
+            const auto bytes = table->memory_usage();
+            return { std::move(table), bytes };
+        }
+        catch (const std::exception&)
+        {
+            return {};
+        }
+    }
+
+} // namespace linguist
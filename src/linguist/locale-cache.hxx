@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include "linguist/atomic-shared-ptr.hxx"
+#include "linguist/mapped-file.hxx"
+#include "linguist/translation-table.hxx"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace linguist
+{
+    /// Locale of a catalog and the number of identifiers translated into it
+    struct locale_info
+    {
+        /// Count of a locale that is only known once it is loaded
+        static constexpr std::size_t unknown = static_cast<std::size_t>(-1);
+
+        /// Locale code
+        std::string_view locale;
+
+        /// Number of identifiers translated into the locale, or unknown
+        std::size_t translated{ 0 };
+    };
+
+    /// Translations of a single locale embedded at build time
+    struct embedded_locale
+    {
+        /// Locale code
+        std::string_view locale;
+
+        /// Sections of the locale's translation table
+        table_data data;
+
+        /// Compressed catalog of the locale, decompressed on first use instead of viewing data when not empty
+        std::span<const char> compressed;
+    };
+
+    /// View a mapped binary catalog as a table that keeps the file mapped
+    ///
+    /// Compressed catalogs are decompressed into memory owned by the table,
+    /// and the file is unmapped.
+    ///
+    /// \param mapping Mapping of a catalog written by write_catalog()
+    /// \return Table viewing the mapped pages, or nullptr if the mapping is not a valid catalog
+    [[nodiscard]] auto view_mapped_catalog(mapped_file mapping) -> std::shared_ptr<const translation_table>;
+
+    /// Decompress a compressed binary catalog into a table that owns the decompressed bytes
+    ///
+    /// \param catalog Catalog written by write_catalog() with catalog_compression::lz
+    /// \return Table viewing the decompressed catalog, or nullptr if the bytes are not a valid compressed catalog
+    [[nodiscard]] auto view_compressed_catalog(std::span<const char> catalog) -> std::shared_ptr<const translation_table>;
+
+    /// Per-locale translation tables, materialised on first use
+    ///
+    /// Each locale comes from its own source: constant embedded sections, a
+    /// compressed embedded catalog (decompressed), a binary catalog (mapped,
+    /// or decompressed if compressed) or a JSON catalog (parsed). Materialised locales
+    /// are evicted least recently used first once their memory exceeds the
+    /// limit, except while a table is still referenced elsewhere. Eviction runs
+    /// whenever a locale is materialised, and on trim().
+    ///
+    /// Materialising is thread-safe. Loaded tables are served without locking,
+    /// and loading a locale only blocks the threads that need that locale. A
+    /// source that fails to load is not retried. Lookups must hold the table
+    /// they read, since other threads loading locales may evict it.
+    ///
+    class locale_cache
+    {
+    public:
+        /// Source of a locale's translations
+        struct source
+        {
+            /// Locale code
+            std::string locale;
+
+            /// Binary (.lcat) or JSON catalog, or empty for embedded sections
+            std::filesystem::path path;
+
+            /// Embedded sections, used when path and compressed are empty
+            table_data data;
+
+            /// Embedded compressed catalog, used when path is empty
+            std::span<const char> compressed;
+        };
+
+        /// Construct a cache over a set of sources
+        ///
+        /// \param sources Source of each locale
+        /// \param memory_limit Bytes of materialised locales to keep, or 0 for no limit
+        locale_cache(std::vector<source> sources, std::size_t memory_limit);
+
+        /// Discover one catalog per locale in a directory
+        ///
+        /// \param directory Directory holding <locale>.lcat or <locale>.json files
+        /// \return Source of each locale, preferring binary catalogs, sorted by locale code
+        [[nodiscard]] static auto scan(const std::filesystem::path& directory) -> std::vector<source>;
+
+        /// Get the number of locales
+        ///
+        /// \return Number of sources
+        [[nodiscard]] auto locale_count() const noexcept -> std::size_t;
+
+        /// Get the code of a locale
+        ///
+        /// \param locale Index of the locale
+        /// \return Locale code
+        [[nodiscard]] auto locale(std::size_t locale) const noexcept -> std::string_view;
+
+        /// Count the identifiers translated into a locale
+        ///
+        /// Embedded sections and binary catalogs store their counts, which are
+        /// read when the cache is constructed. Compressed and JSON catalogs are
+        /// counted when they are first materialised.
+        ///
+        /// \param locale Index of the locale
+        /// \return Number of translations, or std::nullopt if the locale must be loaded to count them and has not been
+        [[nodiscard]] auto translated_count(std::size_t locale) const noexcept -> std::optional<std::size_t>;
+
+        /// Get the registry of the locales and their translated counts
+        ///
+        /// Counts learnt by materialising locales appear in the next registry
+        /// returned. Earlier registries are kept, so that every span returned
+        /// remains valid for the lifetime of the cache.
+        ///
+        /// \return Each locale, in source order
+        [[nodiscard]] auto registry() const -> std::span<const locale_info>;
+
+        /// Find the index of a locale code
+        ///
+        /// \param locale Locale code
+        /// \return Index of the locale if it has a source
+        [[nodiscard]] auto find_locale(std::string_view locale) const noexcept -> std::optional<std::size_t>;
+
+        /// Get the table of a locale, materialising it if needed
+        ///
+        /// \param locale Index of the locale
+        /// \return Table of the locale, or nullptr if its source could not be loaded the first time
+        [[nodiscard]] auto acquire(std::size_t locale) const -> std::shared_ptr<const translation_table>;
+
+        /// Evict unreferenced locales, least recently used first, until within the memory limit
+        void trim();
+
+        /// Get the locales currently materialised
+        ///
+        /// \return Locale codes
+        [[nodiscard]] auto loaded_locales() const -> std::vector<std::string>;
+
+        /// Get the memory used by materialised locales
+        ///
+        /// \return Heap bytes of parsed and decompressed catalogs plus mapped bytes of binary catalogs
+        [[nodiscard]] auto memory_usage() const -> std::size_t;
+
+    private:
+        /// Table loaded from a source, and the bytes it counts against the memory limit
+        struct materialised
+        {
+            std::shared_ptr<const translation_table> table;
+            std::size_t bytes{ 0 };
+        };
+
+        struct entry
+        {
+            /// Loaded table, read without locking
+            atomic_shared_ptr<const translation_table> table;
+
+            /// Serialises loading this locale, so that other locales are not held up
+            std::mutex load_mutex;
+
+            /// Set once the source failed to load, so that it is not read again
+            std::atomic<bool> failed{ false };
+
+            std::atomic<std::uint64_t> last_used{ 0 };
+
+            /// Bytes of the loaded table, guarded by the cache's mutex
+            std::size_t bytes{ 0 };
+
+            /// Number of translations, or locale_info::unknown until the locale is loaded
+            std::atomic<std::size_t> translated{ locale_info::unknown };
+        };
+
+        /// Registry of the counts known once a number of locales were counted by loading them
+        struct registry_version
+        {
+            std::uint64_t counted{ 0 };
+            std::vector<locale_info> locales;
+        };
+
+        /// Release unreferenced tables, least recently used first, until within the memory limit; mutex_ must be held
+        void evict() const;
+
+        /// Load a locale's table from its source
+        [[nodiscard]] auto materialise(const source& source) const -> materialised;
+
+        /// Count a locale's translations without loading it, or locale_info::unknown if it must be loaded
+        [[nodiscard]] static auto stored_count(const source& source) -> std::size_t;
+
+    private:
+        std::vector<source> sources_;
+        std::size_t memory_limit_;
+
+        /// Guards the memory accounting and eviction, never held while loading
+        mutable std::mutex mutex_;
+        mutable std::vector<entry> entries_;
+        mutable std::size_t memory_usage_{ 0 };
+        mutable std::atomic<std::uint64_t> clock_{ 0 };
+
+        /// Number of locales counted by loading them, so that registry() notices new counts without locking
+        mutable std::atomic<std::uint64_t> counted_{ 0 };
+        mutable std::atomic<const registry_version*> registry_{ nullptr };
+        mutable std::mutex registry_mutex_;
+        mutable std::vector<std::unique_ptr<const registry_version>> registries_;
+    };
+
+} // namespace linguist
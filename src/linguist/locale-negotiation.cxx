@@ -0,0 +1,278 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/locale-negotiation.hxx"
+
+#include <array>
+#include <mutex>
+
+namespace linguist
+{
+    namespace
+    {
+        /// Remove the optional whitespace around a list element
+        auto trim(std::string_view value) noexcept -> std::string_view
+        {
+            const auto first = value.find_first_not_of(" \t");
+            if (first == std::string_view::npos)
+            {
+                return {};
+            }
+
+            return value.substr(first, value.find_last_not_of(" \t") - first + 1);
+        }
+
+        auto is_alpha(char c) noexcept -> bool
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+
+        auto is_digit(char c) noexcept -> bool
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        auto is_separator(char c) noexcept -> bool
+        {
+            return c == '-' || c == '_';
+        }
+
+        /// Fold a locale code character for comparison, ignoring case and the separator used
+        auto fold(char c) noexcept -> char
+        {
+            if (c >= 'A' && c <= 'Z')
+            {
+                return static_cast<char>(c - 'A' + 'a');
+            }
+
+            return c == '_' ? '-' : c;
+        }
+
+        /// Check that a range is a language tag, starting with a letter and without empty subtags
+        auto is_valid_range(std::string_view range) noexcept -> bool
+        {
+            if (range.empty() || !is_alpha(range.front()) || is_separator(range.back()))
+            {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < range.size(); ++i)
+            {
+                const auto c = range[i];
+                if (is_separator(c) ? is_separator(range[i - 1]) : !is_alpha(c) && !is_digit(c))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// Parse a quality value ("0", "0.8", "1.000") into thousandths
+        auto parse_quality(std::string_view value) noexcept -> std::optional<std::uint16_t>
+        {
+            if (value.empty() || (value[0] != '0' && value[0] != '1') || (value.size() > 1 && value[1] != '.') || value.size() > 5)
+            {
+                return std::nullopt;
+            }
+
+            std::uint16_t quality = value[0] == '1' ? weighted_locale::max_quality : 0;
+            std::uint16_t scale = 100;
+            for (std::size_t i = 2; i < value.size(); ++i, scale /= 10)
+            {
+                if (!is_digit(value[i]))
+                {
+                    return std::nullopt;
+                }
+
+                quality += static_cast<std::uint16_t>((value[i] - '0') * scale);
+            }
+
+            return quality > weighted_locale::max_quality ? std::nullopt : std::optional(quality);
+        }
+
+        /// Insert a range after the ranges of the same or higher quality, dropping the lowest one when full
+        auto insert_range(std::span<weighted_locale> ranges, std::size_t count, weighted_locale range) noexcept -> std::size_t
+        {
+            std::size_t position = 0;
+            while (position < count && ranges[position].quality >= range.quality)
+            {
+                ++position;
+            }
+
+            if (position == ranges.size())
+            {
+                return count;
+            }
+
+            const auto last = count < ranges.size() ? count++ : count - 1;
+            for (auto i = last; i > position; --i)
+            {
+                ranges[i] = ranges[i - 1];
+            }
+
+            ranges[position] = range;
+            return count;
+        }
+
+        /// Compare locale codes ignoring case and the separator used
+        auto same_locale(std::string_view a, std::string_view b) noexcept -> bool
+        {
+            if (a.size() != b.size())
+            {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                if (fold(a[i]) != fold(b[i]))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// Get the primary language subtag of a locale code (e.g., "fr" of "fr-CH")
+        auto language_of(std::string_view locale) noexcept -> std::string_view
+        {
+            return locale.substr(0, locale.find_first_of("-_"));
+        }
+
+        auto find_available(std::span<const locale_info> available, std::string_view locale) noexcept -> std::optional<std::size_t>
+        {
+            for (std::size_t i = 0; i < available.size(); ++i)
+            {
+                if (same_locale(available[i].locale, locale))
+                {
+                    return i;
+                }
+            }
+
+            return std::nullopt;
+        }
+    } // namespace
+
+    auto parse_locale_preferences(std::string_view preferences, std::span<weighted_locale> ranges) noexcept -> std::size_t
+    {
+        std::size_t count = 0;
+        for (std::size_t position = 0; position <= preferences.size();)
+        {
+            auto end = preferences.find(',', position);
+            end = end == std::string_view::npos ? preferences.size() : end;
+            auto element = preferences.substr(position, end - position);
+            position = end + 1;
+
+            // Parameters other than the weight (e.g., "level=1") are ignored
+            weighted_locale range{ trim(element.substr(0, element.find(';'))) };
+            bool valid = is_valid_range(range.locale);
+            for (auto parameter = element.find(';'); valid && parameter != std::string_view::npos;)
+            {
+                const auto next = element.find(';', parameter + 1);
+                const auto value = trim(element.substr(parameter + 1, next == std::string_view::npos ? std::string_view::npos : next - parameter - 1));
+                if (value.size() >= 2 && fold(value[0]) == 'q' && value[1] == '=')
+                {
+                    const auto quality = parse_quality(trim(value.substr(2)));
+                    valid = quality.has_value();
+                    range.quality = quality.value_or(0);
+                }
+
+                parameter = next;
+            }
+
+            if (valid && range.quality > 0)
+            {
+                count = insert_range(ranges, count, range);
+            }
+        }
+
+        return count;
+    }
+
+    auto match_locale(std::span<const weighted_locale> ranges, std::span<const locale_info> available) noexcept -> std::optional<std::size_t>
+    {
+        for (const auto& range : ranges)
+        {
+            // Lookup: truncate the range one subtag at a time, along with a singleton left at its end (e.g., "x" of "en-x-private")
+            auto candidate = range.locale;
+            for (;;)
+            {
+                if (auto index = find_available(available, candidate); index)
+                {
+                    return index;
+                }
+
+                const auto separator = candidate.find_last_of("-_");
+                if (separator == std::string_view::npos)
+                {
+                    break;
+                }
+
+                candidate = candidate.substr(0, separator);
+                if (candidate.size() >= 2 && is_separator(candidate[candidate.size() - 2]))
+                {
+                    candidate = candidate.substr(0, candidate.size() - 2);
+                }
+            }
+
+            // Regional variant of the range's language
+            for (std::size_t i = 0; i < available.size(); ++i)
+            {
+                if (same_locale(language_of(available[i].locale), candidate))
+                {
+                    return i;
+                }
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    locale_negotiator::locale_negotiator(catalog translations, std::string default_locale, std::size_t cache_capacity)
+        : catalog_(std::move(translations)), default_locale_(std::move(default_locale)), cache_capacity_(cache_capacity)
+    {
+    }
+
+    auto locale_negotiator::negotiate(std::string_view preferences) const -> locale_view
+    {
+        {
+            std::shared_lock lock(cache_mutex_);
+            if (const auto cached = cache_.find(preferences); cached != cache_.end())
+            {
+                return cached->second;
+            }
+        }
+
+        const auto locale = find_locale(preferences);
+        auto view = catalog_.view(locale ? *locale : std::string_view(default_locale_), default_locale_);
+        if (cache_capacity_ > 0)
+        {
+            std::unique_lock lock(cache_mutex_);
+            if (cache_.size() >= cache_capacity_)
+            {
+                cache_.clear();
+            }
+
+            cache_.emplace(preferences, view);
+        }
+
+        return view;
+    }
+
+    auto locale_negotiator::find_locale(std::string_view preferences) const noexcept -> std::optional<std::string_view>
+    {
+        std::array<weighted_locale, max_ranges> ranges;
+        const auto count = parse_locale_preferences(preferences, ranges);
+
+        const auto available = catalog_.available_locales();
+        if (const auto index = match_locale(std::span(ranges.data(), count), available); index)
+        {
+            return available[*index].locale;
+        }
+
+        return std::nullopt;
+    }
+
+} // namespace linguist
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include "linguist/catalog.hxx"
+#include "linguist/translation-table.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace linguist
+{
+    /// Locale range of a weighted preference list (e.g., "fr;q=0.9" of an Accept-Language header)
+    struct weighted_locale
+    {
+        /// Highest quality, given to ranges without a weight
+        static constexpr std::uint16_t max_quality = 1000;
+
+        /// Language range, viewing the parsed list (e.g., "fr-CH")
+        std::string_view locale;
+
+        /// Weight of the range in thousandths, from 1 to max_quality
+        std::uint16_t quality{ max_quality };
+    };
+
+    /// Parse a weighted locale preference list without allocating
+    ///
+    /// Ranges are separated by commas and weighted by an optional ";q=" value,
+    /// as in Accept-Language headers (e.g., "fr-CH, fr;q=0.9, en;q=0.8, *;q=0.5").
+    /// Ranges weighted 0, wildcards and malformed ranges are skipped. When
+    /// there are more ranges than room, the lowest weighted ones are dropped.
+    ///
+    /// \param preferences Preference list
+    /// \param ranges Receives the ranges by decreasing quality, in list order among equal qualities
+    /// \return Number of ranges written
+    [[nodiscard]] auto parse_locale_preferences(std::string_view preferences, std::span<weighted_locale> ranges) noexcept -> std::size_t;
+
+    /// Find the available locale that best matches weighted preferences
+    ///
+    /// Ranges are tried by decreasing quality. Each is matched with the BCP 47
+    /// lookup rules, ignoring case and treating '_' as '-': the whole range
+    /// first, then with its last subtag truncated until only the language is
+    /// left (e.g., "zh-Hant-TW", "zh-Hant", "zh"). Failing that, the range
+    /// matches the first available regional variant of its language (e.g.,
+    /// "fr-CH" matches "fr-FR"), as lookups fall back to regional variants.
+    ///
+    /// \param ranges Ranges returned by parse_locale_preferences()
+    /// \param available Available locales, such as catalog::available_locales()
+    /// \return Index of the best available locale, or std::nullopt if no range matches
+    [[nodiscard]] auto match_locale(std::span<const weighted_locale> ranges, std::span<const locale_info> available) noexcept
+        -> std::optional<std::size_t>;
+
+    /// Negotiates the locale of each request from its preference list
+    ///
+    /// Requests usually repeat a handful of Accept-Language headers, so the
+    /// view resolved for each header is cached and returned again to later
+    /// requests sending the same header, under a shared lock. The cache is
+    /// cleared when it is full, so that rare headers cannot pin it.
+    ///
+    class locale_negotiator
+    {
+    public:
+        /// Construct a negotiator of a catalog's locales
+        ///
+        /// \param translations Catalog whose available locales are negotiated
+        /// \param default_locale Locale used when no preference matches, and tried after the negotiated locale
+        /// \param cache_capacity Number of preference lists whose view is cached
+        explicit locale_negotiator(catalog translations, std::string default_locale = {}, std::size_t cache_capacity = 1024);
+
+        /// Disable copy
+        locale_negotiator(const locale_negotiator&) = delete;
+
+        /// Disable copy
+        locale_negotiator& operator=(const locale_negotiator&) = delete;
+
+        /// Negotiate the locale of a preference list
+        ///
+        /// \param preferences Preference list, such as an Accept-Language header
+        /// \return View of the best matching locale, or of the default locale if none matches
+        [[nodiscard]] auto negotiate(std::string_view preferences) const -> locale_view;
+
+        /// Negotiate the locale code of a preference list, without resolving or caching its view
+        ///
+        /// \param preferences Preference list, such as an Accept-Language header
+        /// \return Best matching locale code, valid as long as the catalog, or std::nullopt if none matches
+        [[nodiscard]] auto find_locale(std::string_view preferences) const noexcept -> std::optional<std::string_view>;
+
+    private:
+        /// Most ranges of a preference list considered
+        static constexpr std::size_t max_ranges = 16;
+
+    private:
+        catalog catalog_;
+        std::string default_locale_;
+        std::size_t cache_capacity_;
+        mutable std::shared_mutex cache_mutex_;
+        mutable std::unordered_map<std::string, locale_view, string_hash, std::equal_to<>> cache_;
+    };
+
+} // namespace linguist
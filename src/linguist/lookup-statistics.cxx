@@ -0,0 +1,186 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/lookup-statistics.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+namespace linguist
+{
+    namespace
+    {
+        /// Source of the shard each thread counts into
+        std::atomic<std::size_t> next_shard{ 0 };
+
+        /// Shard of the current thread
+        thread_local const std::size_t thread_shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+
+        /// Lookups made by the current thread, to pick the sampled ones
+        thread_local std::uint32_t thread_lookups = 0;
+
+        /// Get the current time in nanoseconds, never 0
+        auto now() noexcept -> std::uint64_t
+        {
+            const auto time = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count()) | 1;
+        }
+    } // namespace
+
+    auto statistics_snapshot::latency_samples() const noexcept -> std::uint64_t
+    {
+        std::uint64_t samples = 0;
+        for (const auto count : latency_histogram)
+        {
+            samples += count;
+        }
+
+        return samples;
+    }
+
+    auto statistics_snapshot::latency_quantile(double quantile) const noexcept -> std::uint64_t
+    {
+        const auto samples = latency_samples();
+        if (samples == 0)
+        {
+            return 0;
+        }
+
+        const auto rank = static_cast<std::uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(samples - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < latency_buckets; ++bucket)
+        {
+            seen += latency_histogram[bucket];
+            if (seen >= rank)
+            {
+                return std::uint64_t{ 1 } << bucket;
+            }
+        }
+
+        return std::uint64_t{ 1 } << (latency_buckets - 1);
+    }
+
+    lookup_statistics::lookup_statistics(const statistics_options& options)
+        : sample_mask_(std::bit_ceil(std::max<std::uint32_t>(options.latency_sample_interval, 1)) - 1),
+          sampling_(options.latency_sample_interval != 0),
+          missing_capacity_(options.missing_keys)
+    {
+        for (auto& shard : shards_)
+        {
+            shard.missing.reserve(missing_capacity_);
+        }
+    }
+
+    auto lookup_statistics::start_sample() noexcept -> std::uint64_t
+    {
+        if (!sampling_ || (++thread_lookups & sample_mask_) != 0)
+        {
+            return 0;
+        }
+
+        return now();
+    }
+
+    void lookup_statistics::record(lookup_result result, std::string_view identifier, std::uint64_t sample)
+    {
+        if (sample != 0)
+        {
+            const auto elapsed = now() - sample;
+            const auto bucket = std::min<std::size_t>(std::bit_width(elapsed), statistics_snapshot::latency_buckets - 1);
+            latency_[bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto& shard = shards_[thread_shard % shard_count];
+        shard.results[static_cast<std::size_t>(result)].fetch_add(1, std::memory_order_relaxed);
+        if (result != lookup_result::missing || missing_capacity_ == 0)
+        {
+            return;
+        }
+
+        // Space-saving: an untracked identifier replaces the least missed one, inheriting its count
+        std::lock_guard lock(shard.missing_mutex);
+        auto& missing = shard.missing;
+        auto entry = std::find_if(missing.begin(), missing.end(), [&](const missing_key& key) { return key.identifier == identifier; });
+        if (entry == missing.end())
+        {
+            if (missing.size() < missing_capacity_)
+            {
+                missing.push_back({ std::string(identifier), 0 });
+                entry = missing.end() - 1;
+            }
+            else
+            {
+                entry = std::min_element(missing.begin(), missing.end(), [](const missing_key& a, const missing_key& b) { return a.count < b.count; });
+                entry->identifier = identifier;
+            }
+        }
+
+        ++entry->count;
+    }
+
+    auto lookup_statistics::snapshot() const -> statistics_snapshot
+    {
+        statistics_snapshot statistics;
+        statistics.enabled = true;
+        for (const auto& shard : shards_)
+        {
+            for (std::size_t i = 0; i < shard.results.size(); ++i)
+            {
+                statistics.results[i] += shard.results[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        for (std::size_t bucket = 0; bucket < latency_.size(); ++bucket)
+        {
+            statistics.latency_histogram[bucket] = latency_[bucket].load(std::memory_order_relaxed);
+        }
+
+        // The shards' counts of an identifier add up, as do their overestimates
+        auto& missing = statistics.missing_keys;
+        for (const auto& shard : shards_)
+        {
+            std::lock_guard lock(shard.missing_mutex);
+            for (const auto& key : shard.missing)
+            {
+                if (auto entry = std::find_if(missing.begin(), missing.end(), [&](const missing_key& merged) { return merged.identifier == key.identifier; });
+                    entry != missing.end())
+                {
+                    entry->count += key.count;
+                }
+                else
+                {
+                    missing.push_back(key);
+                }
+            }
+        }
+
+        std::stable_sort(missing.begin(), missing.end(), [](const missing_key& a, const missing_key& b) { return a.count > b.count; });
+        missing.resize(std::min(missing.size(), missing_capacity_));
+        return statistics;
+    }
+
+    void lookup_statistics::reset()
+    {
+        for (auto& shard : shards_)
+        {
+            for (auto& count : shard.results)
+            {
+                count.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        for (auto& count : latency_)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+
+        for (auto& shard : shards_)
+        {
+            std::lock_guard lock(shard.missing_mutex);
+            shard.missing.clear();
+        }
+    }
+
+} // namespace linguist
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Whether lookups can collect statistics (set by the BUILD_WITH_LOOKUP_STATISTICS CMake option)
+#if !defined(LINGUIST_STATISTICS)
+#define LINGUIST_STATISTICS 1
+#endif
+
+namespace linguist
+{
+    /// How a lookup was resolved
+    enum class lookup_result : std::uint8_t
+    {
+        /// Found in the requested locale
+        exact,
+
+        /// Found further down the locale chain: base language, regional variant or default locale
+        base_language,
+
+        /// Found in whichever locale translates the identifier first, as a last resort
+        any_locale,
+
+        /// Not translated at all
+        missing,
+    };
+
+    /// Options of the statistics collected by translator::enable_statistics()
+    struct statistics_options
+    {
+        /// Number of most frequently missing identifiers tracked
+        std::size_t missing_keys{ 16 };
+
+        /// Time one lookup in this many on each thread (rounded up to a power of two), or none if 0
+        std::uint32_t latency_sample_interval{ 0 };
+    };
+
+    /// Identifier looked up without a translation
+    struct missing_key
+    {
+        std::string identifier;
+
+        /// Number of failed lookups, which may be overestimated for identifiers that displaced others
+        std::uint64_t count{ 0 };
+    };
+
+    /// Statistics collected since they were enabled or last reset
+    struct statistics_snapshot
+    {
+        /// Number of histogram buckets; bucket i counts latencies below 2^i ns not counted by bucket i - 1
+        static constexpr std::size_t latency_buckets = 32;
+
+        /// Whether statistics were being collected
+        bool enabled{ false };
+
+        /// Lookups of each result, indexed by lookup_result
+        std::array<std::uint64_t, 4> results{};
+
+        /// Most frequently missing identifiers, most frequent first
+        std::vector<missing_key> missing_keys;
+
+        /// Sampled lookup latencies, by power of two nanoseconds
+        std::array<std::uint64_t, latency_buckets> latency_histogram{};
+
+        /// Get the number of lookups of a result
+        [[nodiscard]] auto count(lookup_result result) const noexcept -> std::uint64_t
+        {
+            return results[static_cast<std::size_t>(result)];
+        }
+
+        /// Get the number of lookups of every result
+        [[nodiscard]] auto lookups() const noexcept -> std::uint64_t
+        {
+            return results[0] + results[1] + results[2] + results[3];
+        }
+
+        /// Get the number of lookups whose latency was sampled
+        [[nodiscard]] auto latency_samples() const noexcept -> std::uint64_t;
+
+        /// Get an upper bound of a latency quantile
+        ///
+        /// \param quantile Quantile between 0 and 1 (e.g., 0.99)
+        /// \return Upper bound of the histogram bucket holding the quantile in nanoseconds, or 0 if nothing was sampled
+        [[nodiscard]] auto latency_quantile(double quantile) const noexcept -> std::uint64_t;
+    };
+
+    /// Lookup counters shared by the snapshots of a translator
+    ///
+    /// Each thread counts into a shard of its own cache line, so that lookups
+    /// on different threads do not contend. Each shard also tracks its missing
+    /// identifiers with the space-saving algorithm, under a lock of its own, and
+    /// snapshot() merges the shards' lists. Latencies are only timed for the
+    /// sampled lookups.
+    ///
+    class lookup_statistics
+    {
+    public:
+        /// Construct empty statistics
+        ///
+        /// \param options Missing identifiers tracked and latency sampling
+        explicit lookup_statistics(const statistics_options& options);
+
+        /// Disable copy
+        lookup_statistics(const lookup_statistics&) = delete;
+
+        /// Disable copy
+        lookup_statistics& operator=(const lookup_statistics&) = delete;
+
+        /// Start timing a lookup if it is sampled
+        ///
+        /// \return Start time to pass to record(), or 0 if the lookup is not sampled
+        [[nodiscard]] auto start_sample() noexcept -> std::uint64_t;
+
+        /// Count a lookup
+        ///
+        /// \param result How the lookup was resolved
+        /// \param identifier Identifier looked up, tracked if missing
+        /// \param sample Start time returned by start_sample()
+        void record(lookup_result result, std::string_view identifier, std::uint64_t sample = 0);
+
+        /// Get the statistics collected so far
+        [[nodiscard]] auto snapshot() const -> statistics_snapshot;
+
+        /// Clear the statistics collected so far
+        void reset();
+
+    private:
+        /// Number of counter shards shared by threads
+        static constexpr std::size_t shard_count = 16;
+
+        /// Counters of the threads using one shard
+        struct alignas(64) shard
+        {
+            std::array<std::atomic<std::uint64_t>, 4> results{};
+
+            /// Guards missing, only contended by threads sharing the shard and by snapshot()
+            mutable std::mutex missing_mutex;
+            std::vector<missing_key> missing;
+        };
+
+    private:
+        std::array<shard, shard_count> shards_;
+        std::array<std::atomic<std::uint64_t>, statistics_snapshot::latency_buckets> latency_{};
+        std::uint32_t sample_mask_{ 0 };
+        bool sampling_{ false };
+        std::size_t missing_capacity_{ 0 };
+    };
+
+} // namespace linguist
@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/mapped-file.hxx"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace linguist
+{
+    auto mapped_file::open(const std::filesystem::path& path) -> std::optional<mapped_file>
+    {
+        const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0)
+        {
+            return std::nullopt;
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        struct stat status{};
+        void* address = MAP_FAILED;
+        if (::fstat(descriptor, &status) == 0 && status.st_size > 0)
+        {
+            address = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+        }
+        ::close(descriptor);
+
+        if (address == MAP_FAILED)
+        {
+            return std::nullopt;
+        }
+
+        mapped_file file;
+        file.data_ = static_cast<const char*>(address);
+        file.size_ = static_cast<std::size_t>(status.st_size);
+        return file;
+    }
+
+    void mapped_file::reset() noexcept
+    {
+        if (data_)
+        {
+            ::munmap(const_cast<char*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+} // namespace linguist
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/mapped-file.hxx"
+
+#include <windows.h>
+
+namespace linguist
+{
+    auto mapped_file::open(const std::filesystem::path& path) -> std::optional<mapped_file>
+    {
+        HANDLE file_handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE)
+        {
+            return std::nullopt;
+        }
+
+        // The view stays valid after the file and mapping handles are closed
+        LARGE_INTEGER size{};
+        HANDLE mapping_handle = nullptr;
+        if (GetFileSizeEx(file_handle, &size) && size.QuadPart > 0)
+        {
+            mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        }
+        CloseHandle(file_handle);
+
+        if (!mapping_handle)
+        {
+            return std::nullopt;
+        }
+
+        const void* address = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping_handle);
+
+        if (!address)
+        {
+            return std::nullopt;
+        }
+
+        mapped_file file;
+        file.data_ = static_cast<const char*>(address);
+        file.size_ = static_cast<std::size_t>(size.QuadPart);
+        return file;
+    }
+
+    void mapped_file::reset() noexcept
+    {
+        if (data_)
+        {
+            UnmapViewOfFile(data_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+} // namespace linguist
@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/mapped-file.hxx"
+
+#include <utility>
+
+namespace linguist
+{
+    mapped_file::~mapped_file()
+    {
+        reset();
+    }
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    auto mapped_file::operator=(mapped_file&& other) noexcept -> mapped_file&
+    {
+        if (this != &other)
+        {
+            reset();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+
+        return *this;
+    }
+
+    auto mapped_file::data() const noexcept -> std::span<const char>
+    {
+        return { data_, size_ };
+    }
+
+} // namespace linguist
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace linguist
+{
+    /// Read-only memory mapping of a file
+    ///
+    /// The mapping is shared with the page cache, so every process mapping the
+    /// same file shares one copy of its pages.
+    ///
+    class mapped_file
+    {
+    public:
+        /// Construct an empty mapping
+        mapped_file() = default;
+
+        /// Unmap the file
+        ~mapped_file();
+
+        /// Disable copy
+        mapped_file(const mapped_file&) = delete;
+
+        /// Disable copy
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        /// Enable move
+        mapped_file(mapped_file&& other) noexcept;
+
+        /// Enable move
+        mapped_file& operator=(mapped_file&& other) noexcept;
+
+        /// Map a file into memory
+        ///
+        /// \param path Path of the file
+        /// \return Mapping of the whole file, or std::nullopt if it cannot be opened, is empty or cannot be mapped
+        [[nodiscard]] static auto open(const std::filesystem::path& path) -> std::optional<mapped_file>;
+
+        /// Get the mapped bytes
+        ///
+        /// \return Contents of the file, aligned to a page boundary
+        [[nodiscard]] auto data() const noexcept -> std::span<const char>;
+
+    private:
+        /// Unmap the file, leaving an empty mapping
+        void reset() noexcept;
+
+    private:
+        const char* data_{ nullptr };
+        std::size_t size_{ 0 };
+    };
+
+} // namespace linguist
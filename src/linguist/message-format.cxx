@@ -0,0 +1,797 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/message-format.hxx"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+namespace linguist
+{
+    namespace
+    {
+        /// Deepest nesting of plurals and selects accepted in a pattern
+        constexpr std::size_t max_message_depth = 32;
+
+        /// Magnitude of a number, which is what integer plural rules depend on
+        constexpr auto magnitude(std::int64_t number) noexcept -> std::uint64_t
+        {
+            return number < 0 ? 0 - static_cast<std::uint64_t>(number) : static_cast<std::uint64_t>(number);
+        }
+
+        /// Japanese, Chinese, Korean, Thai, Vietnamese, Indonesian...
+        auto plural_other(std::int64_t) noexcept -> plural_category
+        {
+            return plural_category::other;
+        }
+
+        /// English, German, Dutch, Swedish, Italian, Spanish...
+        auto plural_one_other(std::int64_t number) noexcept -> plural_category
+        {
+            return magnitude(number) == 1 ? plural_category::one : plural_category::other;
+        }
+
+        /// French and Portuguese, where zero is singular
+        auto plural_french(std::int64_t number) noexcept -> plural_category
+        {
+            return magnitude(number) <= 1 ? plural_category::one : plural_category::other;
+        }
+
+        /// Russian, Ukrainian and Belarusian
+        auto plural_east_slavic(std::int64_t number) noexcept -> plural_category
+        {
+            const auto value = magnitude(number);
+            if (value % 10 == 1 && value % 100 != 11)
+            {
+                return plural_category::one;
+            }
+
+            if (value % 10 >= 2 && value % 10 <= 4 && (value % 100 < 12 || value % 100 > 14))
+            {
+                return plural_category::few;
+            }
+
+            return plural_category::many;
+        }
+
+        /// Polish
+        auto plural_polish(std::int64_t number) noexcept -> plural_category
+        {
+            const auto value = magnitude(number);
+            if (value == 1)
+            {
+                return plural_category::one;
+            }
+
+            if (value % 10 >= 2 && value % 10 <= 4 && (value % 100 < 12 || value % 100 > 14))
+            {
+                return plural_category::few;
+            }
+
+            return plural_category::many;
+        }
+
+        /// Czech and Slovak
+        auto plural_czech(std::int64_t number) noexcept -> plural_category
+        {
+            const auto value = magnitude(number);
+            if (value == 1)
+            {
+                return plural_category::one;
+            }
+
+            return value >= 2 && value <= 4 ? plural_category::few : plural_category::other;
+        }
+
+        /// Arabic
+        auto plural_arabic(std::int64_t number) noexcept -> plural_category
+        {
+            const auto value = magnitude(number);
+            if (value <= 2)
+            {
+                return static_cast<plural_category>(value);
+            }
+
+            if (value % 100 >= 3 && value % 100 <= 10)
+            {
+                return plural_category::few;
+            }
+
+            return value % 100 >= 11 ? plural_category::many : plural_category::other;
+        }
+
+        /// Hebrew
+        auto plural_hebrew(std::int64_t number) noexcept -> plural_category
+        {
+            const auto value = magnitude(number);
+            if (value == 1)
+            {
+                return plural_category::one;
+            }
+
+            return value == 2 ? plural_category::two : plural_category::other;
+        }
+
+        /// Plural rule of each language that does not use plural_one_other()
+        struct language_rule
+        {
+            std::string_view language;
+            plural_rule rule;
+        };
+
+        constexpr language_rule language_rules[] = {
+            { "ar", plural_arabic },
+            { "be", plural_east_slavic },
+            { "cs", plural_czech },
+            { "fr", plural_french },
+            { "he", plural_hebrew },
+            { "id", plural_other },
+            { "ja", plural_other },
+            { "km", plural_other },
+            { "ko", plural_other },
+            { "lo", plural_other },
+            { "ms", plural_other },
+            { "my", plural_other },
+            { "pl", plural_polish },
+            { "pt", plural_french },
+            { "ru", plural_east_slavic },
+            { "sk", plural_czech },
+            { "th", plural_other },
+            { "uk", plural_east_slavic },
+            { "vi", plural_other },
+            { "zh", plural_other },
+        };
+
+        /// Plural category names, indexed by plural_category
+        constexpr std::string_view plural_category_names[] = { "zero", "one", "two", "few", "many", "other" };
+
+        auto is_white_space(char character) noexcept -> bool
+        {
+            return character == ' ' || character == '\t' || character == '\n' || character == '\r';
+        }
+
+        auto is_name_character(char character) noexcept -> bool
+        {
+            return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') || (character >= '0' && character <= '9') ||
+                character == '_' || character == '-';
+        }
+
+        /// Recursive descent compiler of message patterns
+        class message_compiler
+        {
+        public:
+            message_compiler(std::string_view pattern, std::vector<message_op>& ops, std::string& error)
+                : pattern_(pattern), ops_(ops), base_(ops.size()), error_(error)
+            {
+            }
+
+            [[nodiscard]] auto compile() -> bool
+            {
+                if (pattern_.size() >= std::numeric_limits<std::uint32_t>::max())
+                {
+                    return fail("message exceeds 4 GiB");
+                }
+
+                if (!parse_body(0, false))
+                {
+                    return false;
+                }
+
+                if (position_ < pattern_.size())
+                {
+                    return fail("unmatched '}'");
+                }
+
+                return true;
+            }
+
+        private:
+            /// Parse text and placeholders up to the end of the pattern or a closing brace
+            [[nodiscard]] auto parse_body(std::size_t depth, bool in_plural) -> bool
+            {
+                while (position_ < pattern_.size() && pattern_[position_] != '}')
+                {
+                    if (pattern_[position_] == '{')
+                    {
+                        if (!parse_argument(depth, in_plural))
+                        {
+                            return false;
+                        }
+                    }
+                    else
+                    {
+                        parse_text(in_plural);
+                    }
+                }
+
+                return true;
+            }
+
+            /// Parse literal text, resolving apostrophe quoting
+            void parse_text(bool in_plural)
+            {
+                auto first = position_;
+                while (position_ < pattern_.size())
+                {
+                    const char character = pattern_[position_];
+                    if (character == '{' || character == '}')
+                    {
+                        break;
+                    }
+
+                    if (character == '#' && in_plural)
+                    {
+                        emit_text(first, position_);
+                        emit(message_opcode::number, position_, 1);
+                        first = ++position_;
+                        continue;
+                    }
+
+                    if (character != '\'' || position_ + 1 == pattern_.size())
+                    {
+                        ++position_;
+                        continue;
+                    }
+
+                    const char next = pattern_[position_ + 1];
+                    if (next == '\'')
+                    {
+                        // Doubled apostrophe: keep the first, skip the second
+                        emit_text(first, position_ + 1);
+                        position_ += 2;
+                        first = position_;
+                    }
+                    else if (next == '{' || next == '}' || (next == '#' && in_plural))
+                    {
+                        // Quoted literal, up to the next single apostrophe
+                        emit_text(first, position_);
+                        first = ++position_;
+                        while (position_ < pattern_.size())
+                        {
+                            if (pattern_[position_] != '\'')
+                            {
+                                ++position_;
+                            }
+                            else if (position_ + 1 < pattern_.size() && pattern_[position_ + 1] == '\'')
+                            {
+                                emit_text(first, position_ + 1);
+                                position_ += 2;
+                                first = position_;
+                            }
+                            else
+                            {
+                                break;
+                            }
+                        }
+
+                        emit_text(first, position_);
+                        position_ = std::min(position_ + 1, pattern_.size());
+                        first = position_;
+                    }
+                    else
+                    {
+                        ++position_;
+                    }
+                }
+
+                emit_text(first, position_);
+            }
+
+            /// Parse a placeholder, plural or select
+            [[nodiscard]] auto parse_argument(std::size_t depth, bool in_plural) -> bool
+            {
+                ++position_;
+                skip_white_space();
+                const auto name = position_;
+                const auto name_size = read_name();
+                if (name_size == 0)
+                {
+                    return fail("expected an argument name");
+                }
+
+                skip_white_space();
+                if (consume('}'))
+                {
+                    emit(message_opcode::argument, name, name_size);
+                    return true;
+                }
+
+                if (!consume(','))
+                {
+                    return fail("expected ',' or '}' after the argument name");
+                }
+
+                skip_white_space();
+                const auto type_offset = position_;
+                const auto type = pattern_.substr(type_offset, read_name());
+                skip_white_space();
+
+                if (type == "number")
+                {
+                    emit(message_opcode::argument, name, name_size);
+                    return consume('}') || fail("number styles are not supported");
+                }
+
+                if (type != "plural" && type != "select")
+                {
+                    return fail("unsupported argument type");
+                }
+
+                if (depth == max_message_depth)
+                {
+                    return fail("message nested too deeply");
+                }
+
+                if (!consume(','))
+                {
+                    return fail("expected ',' after the argument type");
+                }
+
+                const bool plural = type == "plural";
+                const auto index = ops_.size();
+                emit(plural ? message_opcode::plural : message_opcode::select, name, name_size);
+
+                bool has_other = false;
+                for (;;)
+                {
+                    skip_white_space();
+                    if (consume('}'))
+                    {
+                        break;
+                    }
+
+                    // Selector: "=N" or a plural category for plurals, any name for selects
+                    const auto selector = position_;
+                    const bool exact = plural && consume('=');
+                    const auto selector_size = read_name() + (exact ? 1 : 0);
+                    const auto keyword = pattern_.substr(selector, selector_size);
+                    if (selector_size == 0 || (exact && selector_size == 1))
+                    {
+                        return fail("expected a case selector");
+                    }
+
+                    auto code = message_opcode::select_case;
+                    std::uint32_t value = 0;
+                    if (exact)
+                    {
+                        code = message_opcode::exact_case;
+                        const auto [end, result] = std::from_chars(keyword.data() + 1, keyword.data() + keyword.size(), value);
+                        if (result != std::errc{} || end != keyword.data() + keyword.size())
+                        {
+                            return fail("invalid exact plural selector");
+                        }
+                    }
+                    else if (plural)
+                    {
+                        code = message_opcode::plural_case;
+                        const auto category = std::find(std::begin(plural_category_names), std::end(plural_category_names), keyword);
+                        if (category == std::end(plural_category_names))
+                        {
+                            return fail("unknown plural category");
+                        }
+
+                        value = static_cast<std::uint32_t>(category - std::begin(plural_category_names));
+                    }
+
+                    has_other = has_other || keyword == "other";
+
+                    skip_white_space();
+                    if (!consume('{'))
+                    {
+                        return fail("expected '{' after the case selector");
+                    }
+
+                    const auto case_index = ops_.size();
+                    emit(code, selector, selector_size);
+                    ops_[case_index].value = value;
+
+                    if (!parse_body(depth + 1, plural || in_plural))
+                    {
+                        return false;
+                    }
+
+                    if (!consume('}'))
+                    {
+                        return fail("unterminated case");
+                    }
+
+                    ops_[case_index].end = static_cast<std::uint32_t>(ops_.size() - base_);
+                }
+
+                if (!has_other)
+                {
+                    return fail("missing 'other' case");
+                }
+
+                ops_[index].end = static_cast<std::uint32_t>(ops_.size() - base_);
+                return true;
+            }
+
+            void emit(message_opcode code, std::size_t offset, std::size_t size)
+            {
+                ops_.push_back({ code, static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(size), 0, 0 });
+            }
+
+            void emit_text(std::size_t first, std::size_t last)
+            {
+                if (last > first)
+                {
+                    emit(message_opcode::text, first, last - first);
+                }
+            }
+
+            void skip_white_space() noexcept
+            {
+                while (position_ < pattern_.size() && is_white_space(pattern_[position_]))
+                {
+                    ++position_;
+                }
+            }
+
+            [[nodiscard]] auto read_name() noexcept -> std::size_t
+            {
+                const auto first = position_;
+                while (position_ < pattern_.size() && is_name_character(pattern_[position_]))
+                {
+                    ++position_;
+                }
+
+                return position_ - first;
+            }
+
+            [[nodiscard]] auto consume(char character) noexcept -> bool
+            {
+                if (position_ < pattern_.size() && pattern_[position_] == character)
+                {
+                    ++position_;
+                    return true;
+                }
+
+                return false;
+            }
+
+            [[nodiscard]] auto fail(std::string_view message) -> bool
+            {
+                error_ = std::string(message) + " at offset " + std::to_string(position_);
+                ops_.resize(base_);
+                return false;
+            }
+
+        private:
+            std::string_view pattern_;
+            std::vector<message_op>& ops_;
+            std::size_t base_;
+            std::string& error_;
+            std::size_t position_{ 0 };
+        };
+
+        /// Output of a formatted message, counting what does not fit
+        class message_writer
+        {
+        public:
+            explicit message_writer(std::span<char> buffer) noexcept : buffer_(buffer)
+            {
+            }
+
+            void write(std::string_view text) noexcept
+            {
+                if (size_ < buffer_.size())
+                {
+                    std::memcpy(buffer_.data() + size_, text.data(), std::min(text.size(), buffer_.size() - size_));
+                }
+
+                size_ += text.size();
+            }
+
+            void write(std::int64_t number) noexcept
+            {
+                std::array<char, 20> digits;
+                const auto [end, result] = std::to_chars(digits.data(), digits.data() + digits.size(), number);
+                write({ digits.data(), static_cast<std::size_t>(end - digits.data()) });
+            }
+
+            [[nodiscard]] auto size() const noexcept -> std::size_t
+            {
+                return size_;
+            }
+
+        private:
+            std::span<char> buffer_;
+            std::size_t size_{ 0 };
+        };
+
+        /// State shared by the operations of one format call
+        struct format_context
+        {
+            std::string_view pattern;
+            std::span<const message_op> ops;
+            std::span<const message_argument> arguments;
+            plural_rule rule;
+            message_writer& output;
+
+            [[nodiscard]] auto slice(const message_op& op) const noexcept -> std::string_view
+            {
+                return pattern.substr(op.offset, op.size);
+            }
+
+            [[nodiscard]] auto find_argument(const message_op& op) const noexcept -> const message_argument*
+            {
+                const auto name = slice(op);
+                for (const auto& argument : arguments)
+                {
+                    if (argument.name == name)
+                    {
+                        return &argument;
+                    }
+                }
+
+                return nullptr;
+            }
+        };
+
+        /// Choose the case of a plural
+        auto choose_plural_case(const format_context& context, std::size_t index, const message_argument* argument) noexcept -> std::size_t
+        {
+            const auto category = argument && argument->is_number ? context.rule(argument->number) : plural_category::other;
+
+            std::size_t matched = 0;
+            std::size_t other = 0;
+            for (auto i = index + 1; i < context.ops[index].end; i = context.ops[i].end)
+            {
+                const auto& op = context.ops[i];
+                if (op.code == message_opcode::exact_case)
+                {
+                    if (argument && argument->is_number && argument->number == static_cast<std::int64_t>(op.value))
+                    {
+                        return i;
+                    }
+                }
+                else if (matched == 0 && static_cast<plural_category>(op.value) == category)
+                {
+                    matched = i;
+                }
+                else if (static_cast<plural_category>(op.value) == plural_category::other)
+                {
+                    other = i;
+                }
+            }
+
+            return matched != 0 ? matched : other;
+        }
+
+        /// Choose the case of a select
+        auto choose_select_case(const format_context& context, std::size_t index, const message_argument* argument) noexcept -> std::size_t
+        {
+            std::array<char, 20> digits;
+            std::string_view value;
+            if (argument && argument->is_number)
+            {
+                const auto [end, result] = std::to_chars(digits.data(), digits.data() + digits.size(), argument->number);
+                value = { digits.data(), static_cast<std::size_t>(end - digits.data()) };
+            }
+            else if (argument)
+            {
+                value = argument->text;
+            }
+
+            std::size_t other = 0;
+            for (auto i = index + 1; i < context.ops[index].end; i = context.ops[i].end)
+            {
+                const auto selector = context.slice(context.ops[i]);
+                if (argument && selector == value)
+                {
+                    return i;
+                }
+
+                if (selector == "other")
+                {
+                    other = i;
+                }
+            }
+
+            return other;
+        }
+
+        /// Format the operations [first, last)
+        void format_ops(const format_context& context, std::size_t first, std::size_t last, const message_argument* plural) noexcept
+        {
+            auto& output = context.output;
+            for (auto i = first; i < last;)
+            {
+                const auto& op = context.ops[i];
+                switch (op.code)
+                {
+                case message_opcode::text:
+                    output.write(context.slice(op));
+                    ++i;
+                    break;
+
+                case message_opcode::argument:
+                    if (const auto* argument = context.find_argument(op); !argument)
+                    {
+                        output.write("{");
+                        output.write(context.slice(op));
+                        output.write("}");
+                    }
+                    else if (argument->is_number)
+                    {
+                        output.write(argument->number);
+                    }
+                    else
+                    {
+                        output.write(argument->text);
+                    }
+                    ++i;
+                    break;
+
+                case message_opcode::number:
+                    if (plural && plural->is_number)
+                    {
+                        output.write(plural->number);
+                    }
+                    else
+                    {
+                        output.write("#");
+                    }
+                    ++i;
+                    break;
+
+                case message_opcode::plural:
+                case message_opcode::select:
+                {
+                    const auto* argument = context.find_argument(op);
+                    const bool is_plural = op.code == message_opcode::plural;
+                    const auto chosen = is_plural ? choose_plural_case(context, i, argument) : choose_select_case(context, i, argument);
+                    format_ops(context, chosen + 1, context.ops[chosen].end, is_plural ? argument : plural);
+                    i = op.end;
+                    break;
+                }
+
+                default:
+                    // Cases are only reached through their plural or select
+                    i = op.end;
+                    break;
+                }
+            }
+        }
+    } // namespace
+
+    auto plural_rule_for(std::string_view locale) noexcept -> plural_rule
+    {
+        const auto language = locale.substr(0, locale.find_first_of("-_"));
+        for (const auto& entry : language_rules)
+        {
+            if (entry.language == language)
+            {
+                return entry.rule;
+            }
+        }
+
+        return plural_one_other;
+    }
+
+    auto compile_message(std::string_view pattern, std::vector<message_op>& ops, std::string& error) -> bool
+    {
+        return message_compiler(pattern, ops, error).compile();
+    }
+
+    auto is_valid_message(std::string_view pattern, std::span<const message_op> ops) noexcept -> bool
+    {
+        /// Range of operations being checked: a body, or the cases of a plural or select
+        struct scope
+        {
+            std::size_t end{ 0 };
+            message_opcode code{ message_opcode::text };
+            bool has_other{ false };
+        };
+
+        // Each level of nesting opens the cases of a plural or select and the body of one case
+        std::array<scope, 2 * max_message_depth + 1> scopes;
+        std::size_t depth = 0;
+        scopes[0].end = ops.size();
+
+        for (std::size_t i = 0;; ++i)
+        {
+            // Close the scopes ending here; a plural or select must have had an "other" case
+            for (; depth > 0 && scopes[depth].end == i; --depth)
+            {
+                if (scopes[depth].code != message_opcode::text && !scopes[depth].has_other)
+                {
+                    return false;
+                }
+            }
+
+            if (i == ops.size())
+            {
+                return true;
+            }
+
+            const auto& op = ops[i];
+            auto& current = scopes[depth];
+            if (op.offset > pattern.size() || op.size > pattern.size() - op.offset)
+            {
+                return false;
+            }
+
+            if (current.code == message_opcode::text && op.code <= message_opcode::number)
+            {
+                continue;
+            }
+
+            // Plurals, selects and cases open a scope of the operations up to their end, which lies within the enclosing scope
+            if (op.end <= i || op.end > current.end || depth + 1 == scopes.size())
+            {
+                return false;
+            }
+
+            if (current.code == message_opcode::text && (op.code == message_opcode::plural || op.code == message_opcode::select))
+            {
+                // At least the "other" case follows
+                scopes[++depth] = { op.end, op.code, false };
+                continue;
+            }
+
+            // Between its cases, a plural or select holds nothing but cases of its own kind
+            const auto category = static_cast<plural_category>(op.value);
+            const bool is_plural_case = current.code == message_opcode::plural &&
+                ((op.code == message_opcode::plural_case && category <= plural_category::other) || op.code == message_opcode::exact_case);
+            const bool is_select_case = current.code == message_opcode::select && op.code == message_opcode::select_case;
+            if (!is_plural_case && !is_select_case)
+            {
+                return false;
+            }
+
+            current.has_other = current.has_other || (is_plural_case ? op.code == message_opcode::plural_case && category == plural_category::other
+                                                                     : pattern.substr(op.offset, op.size) == "other");
+            scopes[++depth] = { op.end, message_opcode::text, false };
+        }
+    }
+
+    message::message(std::string_view pattern, std::span<const message_op> ops) noexcept : pattern_(pattern), ops_(ops)
+    {
+    }
+
+    auto message::format_to(std::span<char> buffer, std::span<const message_argument> arguments, plural_rule rule) const noexcept -> std::size_t
+    {
+        message_writer output(buffer);
+        if (ops_.empty())
+        {
+            output.write(pattern_);
+            return output.size();
+        }
+
+        const format_context context{ pattern_, ops_, arguments, rule, output };
+        format_ops(context, 0, ops_.size(), nullptr);
+        return output.size();
+    }
+
+    auto message::format(std::span<const message_argument> arguments, plural_rule rule) const -> std::string
+    {
+        // Plain text and short messages fit the first pass; longer ones are formatted again at their exact size
+        std::string text(std::max<std::size_t>(pattern_.size() * 2, 64), '\0');
+        const auto size = format_to(text, arguments, rule);
+        if (size > text.size())
+        {
+            text.resize(size);
+            static_cast<void>(format_to(text, arguments, rule));
+        }
+
+        text.resize(size);
+        return text;
+    }
+
+    auto message::pattern() const noexcept -> std::string_view
+    {
+        return pattern_;
+    }
+
+    auto message::ops() const noexcept -> std::span<const message_op>
+    {
+        return ops_;
+    }
+
+} // namespace linguist
@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace linguist
+{
+    /// Plural category of a number, as named by CLDR
+    enum class plural_category : std::uint32_t
+    {
+        zero,
+        one,
+        two,
+        few,
+        many,
+        other,
+    };
+
+    /// Rule selecting the plural category of an integer in a language
+    using plural_rule = auto (*)(std::int64_t number) noexcept -> plural_category;
+
+    /// Get the plural rule of a locale
+    ///
+    /// Rules cover the cardinal integer forms of the common language families;
+    /// unknown languages use "one" for 1 and "other" for everything else.
+    ///
+    /// \param locale Locale code (e.g., "en-US", "ru-RU")
+    /// \return Plural rule of the locale's language
+    [[nodiscard]] auto plural_rule_for(std::string_view locale) noexcept -> plural_rule;
+
+    /// Operation of a compiled message
+    enum class message_opcode : std::uint32_t
+    {
+        /// Write the pattern characters [offset, offset + size)
+        text,
+
+        /// Write the argument named by the pattern characters [offset, offset + size)
+        argument,
+
+        /// Write the number selecting the enclosing plural ('#')
+        number,
+
+        /// Select a case by the plural category of the named argument; cases follow up to end
+        plural,
+
+        /// Select a case by the text of the named argument; cases follow up to end
+        select,
+
+        /// Case of a plural matching the category in value; its body follows up to end
+        plural_case,
+
+        /// Case of a plural matching the exact number in value (e.g., "=0"); its body follows up to end
+        exact_case,
+
+        /// Case of a select matching the pattern characters [offset, offset + size); its body follows up to end
+        select_case,
+    };
+
+    /// Operation of a compiled message
+    ///
+    /// A message compiles to a flat list of operations. Plurals and selects are
+    /// followed by their cases, and each case by its body, so formatting walks
+    /// the list without parsing the pattern again.
+    ///
+    struct message_op
+    {
+        message_opcode code{ message_opcode::text };
+
+        /// Offset of the text, argument name or selector within the pattern
+        std::uint32_t offset{ 0 };
+
+        /// Size of the text, argument name or selector
+        std::uint32_t size{ 0 };
+
+        /// Plural category or exact number of a case
+        std::uint32_t value{ 0 };
+
+        /// Index of the operation following a plural, select or case body
+        std::uint32_t end{ 0 };
+    };
+
+    /// Named argument of a formatted message
+    struct message_argument
+    {
+        /// Construct a text argument
+        ///
+        /// \param argument_name Name of the placeholder
+        /// \param argument_text Text written for the placeholder and matched by select cases
+        constexpr message_argument(std::string_view argument_name, std::string_view argument_text) noexcept
+            : name(argument_name), text(argument_text)
+        {
+        }
+
+        /// Construct a numeric argument
+        ///
+        /// \param argument_name Name of the placeholder
+        /// \param argument_number Number written for the placeholder and selecting plural cases
+        template <std::integral T>
+        constexpr message_argument(std::string_view argument_name, T argument_number) noexcept
+            : name(argument_name), number(static_cast<std::int64_t>(argument_number)), is_number(true)
+        {
+        }
+
+        std::string_view name;
+        std::string_view text;
+        std::int64_t number{ 0 };
+        bool is_number{ false };
+    };
+
+    /// Compile a message pattern
+    ///
+    /// Patterns follow a subset of ICU MessageFormat: "{name}" and "{name, number}"
+    /// placeholders, "{name, plural, =0 {...} one {...} other {...}}" with '#'
+    /// standing for the number, "{name, select, male {...} other {...}}", and
+    /// apostrophe quoting ("''" for an apostrophe, "'{'" for a literal brace).
+    ///
+    /// \param pattern Message pattern
+    /// \param ops Receives the operations of the message, appended after any already present
+    /// \param error Receives a description of the first error
+    /// \return true if the pattern was compiled
+    /// \return false if the pattern is malformed; ops is left unchanged
+    [[nodiscard]] auto compile_message(std::string_view pattern, std::vector<message_op>& ops, std::string& error) -> bool;
+
+    /// Check that operations are structured as compile_message() writes them
+    ///
+    /// Operations read from outside the process, such as a binary catalog, must
+    /// pass this check before they are formatted: every operation must lie
+    /// within the pattern, plurals and selects must hold only their own kind
+    /// of cases, including an "other" case, and cases must appear nowhere else.
+    ///
+    /// \param pattern Message pattern
+    /// \param ops Operations of the message
+    /// \return true if the message can be formatted
+    [[nodiscard]] auto is_valid_message(std::string_view pattern, std::span<const message_op> ops) noexcept -> bool;
+
+    /// Precompiled message
+    ///
+    /// A message views its pattern and operations, which must outlive it. A
+    /// message without operations is plain text and formats as its pattern.
+    ///
+    class message
+    {
+    public:
+        /// Construct an empty message
+        message() = default;
+
+        /// Construct a message viewing a pattern and its compiled operations
+        ///
+        /// \param pattern Message pattern
+        /// \param ops Operations returned by compile_message(), or empty for plain text
+        message(std::string_view pattern, std::span<const message_op> ops) noexcept;
+
+        /// Format the message into a buffer
+        ///
+        /// Formatting neither allocates nor parses the pattern. Placeholders
+        /// without a matching argument are written as they appear in the pattern.
+        ///
+        /// \param buffer Receives the formatted message, truncated if it does not fit
+        /// \param arguments Arguments of the placeholders
+        /// \param rule Plural rule of the message's language
+        /// \return Size of the whole formatted message, which is larger than buffer if it was truncated
+        [[nodiscard]] auto format_to(std::span<char> buffer, std::span<const message_argument> arguments, plural_rule rule) const noexcept
+            -> std::size_t;
+
+        /// Format the message into a string
+        ///
+        /// \param arguments Arguments of the placeholders
+        /// \param rule Plural rule of the message's language
+        /// \return Formatted message
+        [[nodiscard]] auto format(std::span<const message_argument> arguments, plural_rule rule) const -> std::string;
+
+        /// Get the pattern of the message
+        ///
+        /// \return Message pattern
+        [[nodiscard]] auto pattern() const noexcept -> std::string_view;
+
+        /// Get the compiled operations of the message
+        ///
+        /// \return Operations, or an empty span for plain text
+        [[nodiscard]] auto ops() const noexcept -> std::span<const message_op>;
+
+    private:
+        std::string_view pattern_;
+        std::span<const message_op> ops_;
+    };
+
+} // namespace linguist
@@ -0,0 +1,320 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/translation-catalog.hxx"
+#include "linguist/compression.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace linguist
+{
+    namespace
+    {
+        /// Alignment of every section within a catalog
+        constexpr std::uint64_t section_alignment = 8;
+
+        /// Append a section to the catalog being written
+        template <typename T>
+        void write_section(std::ostream& output, std::uint64_t& position, catalog_section& section, std::span<const T> values)
+        {
+            static constexpr char padding[section_alignment] = {};
+
+            const auto aligned = (position + section_alignment - 1) & ~(section_alignment - 1);
+            output.write(padding, static_cast<std::streamsize>(aligned - position));
+
+            section = { aligned, values.size_bytes() };
+            output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+            position = aligned + values.size_bytes();
+        }
+
+        /// View a section of the catalog, checking its bounds and alignment
+        template <typename T>
+        auto read_section(std::span<const char> catalog, const catalog_section& section) noexcept -> std::optional<std::span<const T>>
+        {
+            if (section.offset > catalog.size() || section.size > catalog.size() - section.offset || section.offset % alignof(T) != 0 ||
+                section.size % sizeof(T) != 0)
+            {
+                return std::nullopt;
+            }
+
+            return std::span<const T>(reinterpret_cast<const T*>(catalog.data() + section.offset), section.size / sizeof(T));
+        }
+
+        /// Read the header of an uncompressed catalog, checking its format
+        auto read_header(std::span<const char> catalog) noexcept -> std::optional<catalog_header>
+        {
+            if (catalog.size() < sizeof(catalog_header) || reinterpret_cast<std::uintptr_t>(catalog.data()) % section_alignment != 0)
+            {
+                return std::nullopt;
+            }
+
+            catalog_header header;
+            std::memcpy(&header, catalog.data(), sizeof(header));
+            if (header.magic != catalog_header{}.magic || header.version != catalog_version || header.byte_order != catalog_header{}.byte_order)
+            {
+                return std::nullopt;
+            }
+
+            return header;
+        }
+
+        /// Get the length of the length-prefixed, null-terminated string at an arena offset
+        auto string_length(std::span<const char> arena, std::uint32_t offset) noexcept -> std::optional<std::size_t>
+        {
+            std::uint32_t length{};
+            if (offset > arena.size() || arena.size() - offset <= sizeof(length))
+            {
+                return std::nullopt;
+            }
+
+            std::memcpy(&length, arena.data() + offset, sizeof(length));
+            if (length >= arena.size() - offset - sizeof(length) || arena[offset + sizeof(length) + length] != '\0')
+            {
+                return std::nullopt;
+            }
+
+            return length;
+        }
+
+        /// Check that every offset refers to a string of the arena, allowing npos where a string is optional
+        auto are_strings(std::span<const char> arena, std::span<const std::uint32_t> offsets, bool optional) noexcept -> bool
+        {
+            return std::all_of(offsets.begin(), offsets.end(),
+                [&](auto offset) { return (optional && offset == translation_table::npos) || string_length(arena, offset).has_value(); });
+        }
+
+        /// Check that the index only refers to rows of the table, and that probing it always ends
+        auto is_valid_index(std::span<const table_slot> index, std::size_t rows, bool perfect_hash) noexcept -> bool
+        {
+            bool has_empty_slot = false;
+            for (const auto& slot : index)
+            {
+                if (slot.row == translation_table::npos && !perfect_hash)
+                {
+                    has_empty_slot = true;
+                }
+                else if (slot.row >= rows)
+                {
+                    return false;
+                }
+            }
+
+            return perfect_hash || index.empty() || has_empty_slot;
+        }
+
+        /// Check that each message's operations stay within its operations, and are structured as compiled
+        auto are_valid_messages(std::span<const char> arena, std::span<const message_op> ops, std::span<const message_slot> messages) noexcept -> bool
+        {
+            for (std::size_t i = 0; i < messages.size(); ++i)
+            {
+                const auto first = messages[i].first;
+                const auto last = i + 1 == messages.size() ? ops.size() : messages[i + 1].first;
+                const auto length = string_length(arena, messages[i].text);
+                if (!length || first > last || last > ops.size())
+                {
+                    return false;
+                }
+
+                const std::string_view pattern(arena.data() + messages[i].text + sizeof(std::uint32_t), *length);
+                if (!is_valid_message(pattern, ops.subspan(first, last - first)))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    } // namespace
+
+    void write_catalog(std::ostream& output, const translation_table& table, catalog_compression compression)
+    {
+        if (compression == catalog_compression::lz)
+        {
+            // Compress the whole catalog, so that repeated text anywhere in it is shared
+            std::ostringstream catalog(std::ios::binary);
+            write_catalog(catalog, table);
+            const auto bytes = catalog.str();
+            const auto compressed = compress(bytes);
+
+            compressed_catalog_header header;
+            header.size = bytes.size();
+            output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            output.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+            if (!output)
+            {
+                throw std::runtime_error("failed to write translation catalog");
+            }
+
+            return;
+        }
+
+        const auto& data = table.data();
+
+        // Reserve the header, then write the sections after it
+        catalog_header header;
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::uint64_t position = sizeof(header);
+        write_section(output, position, header.arena, data.arena);
+        write_section(output, position, header.locales, data.locales);
+        write_section(output, position, header.keys, data.keys);
+        write_section(output, position, header.index, data.index);
+        write_section(output, position, header.matrix, data.matrix);
+        write_section(output, position, header.displacements, data.displacements);
+        write_section(output, position, header.message_ops, data.message_ops);
+        write_section(output, position, header.messages, data.messages);
+
+        // Tables viewing sections without counts are counted once here, rather than on every load
+        std::vector<std::uint32_t> counts(data.counts.begin(), data.counts.end());
+        if (counts.empty())
+        {
+            for (std::size_t locale = 0; locale < table.locale_count(); ++locale)
+            {
+                counts.push_back(static_cast<std::uint32_t>(table.translated_count(static_cast<locale_id>(locale))));
+            }
+        }
+
+        write_section(output, position, header.counts, std::span<const std::uint32_t>(counts));
+
+        // Rewrite the header with the section locations
+        output.seekp(0);
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.seekp(0, std::ios::end);
+
+        if (!output)
+        {
+            throw std::runtime_error("failed to write translation catalog");
+        }
+    }
+
+    auto catalog_translated_count(std::span<const char> catalog, std::string_view locale) noexcept -> std::optional<std::size_t>
+    {
+        const auto header = read_header(catalog);
+        if (!header)
+        {
+            return std::nullopt;
+        }
+
+        const auto arena = read_section<char>(catalog, header->arena);
+        const auto locales = read_section<std::uint32_t>(catalog, header->locales);
+        const auto counts = read_section<std::uint32_t>(catalog, header->counts);
+        if (!arena || !locales || !counts || counts->size() != locales->size())
+        {
+            return std::nullopt;
+        }
+
+        for (std::size_t i = 0; i < locales->size(); ++i)
+        {
+            const auto offset = (*locales)[i];
+            const auto length = string_length(*arena, offset);
+            if (!length)
+            {
+                return std::nullopt;
+            }
+
+            if (std::string_view(arena->data() + offset + sizeof(std::uint32_t), *length) == locale)
+            {
+                return (*counts)[i];
+            }
+        }
+
+        return 0;
+    }
+
+    auto read_catalog(std::span<const char> catalog) noexcept -> std::optional<table_data>
+    {
+        const auto found = read_header(catalog);
+        if (!found)
+        {
+            return std::nullopt;
+        }
+
+        const auto& header = *found;
+
+        const auto arena = read_section<char>(catalog, header.arena);
+        const auto locales = read_section<std::uint32_t>(catalog, header.locales);
+        const auto keys = read_section<std::uint32_t>(catalog, header.keys);
+        const auto index = read_section<table_slot>(catalog, header.index);
+        const auto matrix = read_section<std::uint32_t>(catalog, header.matrix);
+        const auto displacements = read_section<std::uint32_t>(catalog, header.displacements);
+        const auto message_ops = read_section<message_op>(catalog, header.message_ops);
+        const auto messages = read_section<message_slot>(catalog, header.messages);
+        const auto counts = read_section<std::uint32_t>(catalog, header.counts);
+        if (!arena || !locales || !keys || !index || !matrix || !displacements || !message_ops || !messages || !counts)
+        {
+            return std::nullopt;
+        }
+
+        // Check that the sections agree with each other
+        if (locales->size() > std::numeric_limits<locale_id>::max() + std::size_t{ 1 } || matrix->size() != keys->size() * locales->size() ||
+            counts->size() != locales->size() || (!arena->empty() && arena->back() != '\0'))
+        {
+            return std::nullopt;
+        }
+
+        if (std::any_of(counts->begin(), counts->end(), [&](std::uint32_t count) { return count > keys->size(); }))
+        {
+            return std::nullopt;
+        }
+
+        if (displacements->empty() ? (!index->empty() && (!std::has_single_bit(index->size()) || index->size() <= keys->size()))
+                                   : index->size() != keys->size())
+        {
+            return std::nullopt;
+        }
+
+        if (!messages->empty() && messages->back().first >= message_ops->size())
+        {
+            return std::nullopt;
+        }
+
+        // Check every offset once, so that lookups into a truncated or corrupt catalog cannot read outside it
+        if (!are_strings(*arena, *locales, false) || !are_strings(*arena, *keys, false) || !are_strings(*arena, *matrix, true) ||
+            !is_valid_index(*index, keys->size(), !displacements->empty()) || !are_valid_messages(*arena, *message_ops, *messages))
+        {
+            return std::nullopt;
+        }
+
+        return table_data{ *arena, *locales, *keys, *index, *matrix, *displacements, *message_ops, *messages, *counts };
+    }
+
+    auto compressed_catalog_size(std::span<const char> catalog) noexcept -> std::optional<std::size_t>
+    {
+        if (catalog.size() < sizeof(compressed_catalog_header))
+        {
+            return std::nullopt;
+        }
+
+        compressed_catalog_header header;
+        std::memcpy(&header, catalog.data(), sizeof(header));
+        if (header.magic != compressed_catalog_header{}.magic || header.version != catalog_version ||
+            header.byte_order != compressed_catalog_header{}.byte_order)
+        {
+            return std::nullopt;
+        }
+
+        // A corrupt size must not allocate more than the compressed bytes could decompress to
+        const auto compressed = static_cast<std::uint64_t>(catalog.size() - sizeof(compressed_catalog_header));
+        if (header.size > compressed * max_expansion || header.size > std::numeric_limits<std::size_t>::max())
+        {
+            return std::nullopt;
+        }
+
+        return static_cast<std::size_t>(header.size);
+    }
+
+    auto decompress_catalog(std::span<const char> catalog, std::span<char> output) noexcept -> bool
+    {
+        const auto size = compressed_catalog_size(catalog);
+        return size && *size == output.size() && decompress(catalog.subspan(sizeof(compressed_catalog_header)), output);
+    }
+
+} // namespace linguist
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include "linguist/translation-table.hxx"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string_view>
+
+namespace linguist
+{
+    /// Current version of the binary catalog format
+    ///
+    /// Version 2 added compiled messages, version 3 changed the identifier hash
+    /// of the index, and version 4 added the translated count of each locale,
+    /// so older catalogs must be rebuilt.
+    ///
+    inline constexpr std::uint32_t catalog_version = 4;
+
+    /// Location of a table section within a binary catalog
+    struct catalog_section
+    {
+        /// Offset of the section from the start of the catalog, in bytes
+        std::uint64_t offset{ 0 };
+
+        /// Size of the section in bytes
+        std::uint64_t size{ 0 };
+    };
+
+    /// Header at the start of a binary catalog
+    ///
+    /// A catalog is the header followed by the sections of a translation_table,
+    /// each aligned to 8 bytes and stored in native byte order, so that a mapped
+    /// catalog can be viewed in place without parsing.
+    ///
+    struct catalog_header
+    {
+        std::array<char, 8> magic{ 'L', 'N', 'G', 'C', 'A', 'T', '\r', '\n' };
+        std::uint32_t version{ catalog_version };
+        std::uint32_t byte_order{ 0x01020304 };
+        catalog_section arena;
+        catalog_section locales;
+        catalog_section keys;
+        catalog_section index;
+        catalog_section matrix;
+        catalog_section displacements;
+        catalog_section message_ops;
+        catalog_section messages;
+        catalog_section counts;
+    };
+
+    /// Compression of a binary catalog
+    enum class catalog_compression : std::uint32_t
+    {
+        /// Sections stored as they are, viewed in place when mapped
+        none,
+
+        /// Whole catalog compressed with compress(), decompressed into memory when loaded
+        lz,
+    };
+
+    /// Header at the start of a compressed binary catalog
+    ///
+    /// A compressed catalog is the header followed by a whole catalog
+    /// compressed with compress(). It trades the in-place view of a mapped
+    /// catalog for a smaller file or binary.
+    ///
+    struct compressed_catalog_header
+    {
+        std::array<char, 8> magic{ 'L', 'N', 'G', 'C', 'A', 'T', 'Z', '\n' };
+        std::uint32_t version{ catalog_version };
+        std::uint32_t byte_order{ 0x01020304 };
+
+        /// Size of the decompressed catalog in bytes
+        std::uint64_t size{ 0 };
+    };
+
+    /// Write a translation table as a binary catalog
+    ///
+    /// \param output Binary output stream
+    /// \param table Table to write
+    /// \param compression Compression of the catalog
+    void write_catalog(std::ostream& output, const translation_table& table, catalog_compression compression = catalog_compression::none);
+
+    /// Get the decompressed size of a compressed binary catalog
+    ///
+    /// \param catalog Catalog bytes
+    /// \return Size of the decompressed catalog, or std::nullopt if the bytes are not a compressed catalog
+    [[nodiscard]] auto compressed_catalog_size(std::span<const char> catalog) noexcept -> std::optional<std::size_t>;
+
+    /// Decompress a compressed binary catalog
+    ///
+    /// \param catalog Compressed catalog bytes
+    /// \param output Receives the catalog for read_catalog(); must be compressed_catalog_size() bytes, aligned to 8 bytes
+    /// \return true if the catalog was decompressed
+    [[nodiscard]] auto decompress_catalog(std::span<const char> catalog, std::span<char> output) noexcept -> bool;
+
+    /// Count the identifiers translated into a locale of a binary catalog without viewing its table
+    ///
+    /// Only the header, the locale codes and their counts are read, so a mapped
+    /// catalog faults in a few pages rather than its matrix.
+    ///
+    /// \param catalog Catalog bytes, aligned to at least 8 bytes
+    /// \param locale Locale code
+    /// \return Number of translations of the locale, 0 if the catalog lacks it, or std::nullopt if the bytes are not an uncompressed catalog
+    [[nodiscard]] auto catalog_translated_count(std::span<const char> catalog, std::string_view locale) noexcept -> std::optional<std::size_t>;
+
+    /// View the sections of a binary catalog in place
+    ///
+    /// Besides the header and section bounds, every string offset, index slot
+    /// and message operation is checked once against its section, so that a
+    /// truncated or corrupt catalog is rejected rather than read out of
+    /// bounds. This is one pass over the offsets, without parsing or copying.
+    ///
+    /// \param catalog Catalog bytes, aligned to at least 8 bytes
+    /// \return Table sections referring into the catalog, or std::nullopt if it is not a valid catalog
+    [[nodiscard]] auto read_catalog(std::span<const char> catalog) noexcept -> std::optional<table_data>;
+
+} // namespace linguist
@@ -0,0 +1,771 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include "linguist/translation-table.hxx"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <xmmintrin.h>
+#endif
+
+namespace linguist
+{
+    /// Block holding every section of a table built at runtime
+    struct translation_table::storage
+    {
+        /// Alignment of the block, suiting every section
+        static constexpr std::size_t alignment = std::max({ alignof(std::uint32_t), alignof(table_slot), alignof(message_op), alignof(message_slot) });
+
+        storage(std::pmr::memory_resource* resource, std::size_t size) : resource(resource), size(size), block(resource->allocate(size, alignment))
+        {
+        }
+
+        storage(const storage&) = delete;
+        storage& operator=(const storage&) = delete;
+
+        ~storage()
+        {
+            resource->deallocate(block, size, alignment);
+        }
+
+        std::pmr::memory_resource* resource;
+        std::size_t size;
+        void* block;
+    };
+
+    /// Sections of a table being built, before they are packed into one block
+    ///
+    /// The arena is only laid out: its strings are written straight into the
+    /// block once every section's size is known.
+    ///
+    struct translation_table::sections
+    {
+        /// Strings of the arena in order, locale codes and identifiers first, then translations
+        std::vector<std::string_view> strings;
+
+        /// Number of locale codes and identifiers leading the strings
+        std::size_t names{ 0 };
+
+        /// Size of the arena in bytes
+        std::size_t arena_size{ 0 };
+
+        std::vector<std::uint32_t> locales;
+        std::vector<std::uint32_t> keys;
+        std::vector<table_slot> index;
+        std::vector<std::uint32_t> matrix;
+        std::vector<std::uint32_t> displacements;
+        std::vector<message_op> message_ops;
+        std::vector<message_slot> messages;
+        std::vector<std::uint32_t> counts;
+    };
+
+    namespace
+    {
+        /// Odd multipliers of the identifier hash, with balanced bits
+        constexpr std::array<std::uint64_t, 4> hash_secret = { 0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull,
+            0x4D5A2DA51DE1AA47ull };
+
+        /// Multiply two words into 128 bits, replacing them with the low and high halves of the product
+        inline void multiply(std::uint64_t& a, std::uint64_t& b) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            const auto product = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<std::uint64_t>(product);
+            b = static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            a = _umul128(a, b, &b);
+#else
+            const auto a_high = a >> 32;
+            const auto a_low = a & 0xFFFFFFFFull;
+            const auto b_high = b >> 32;
+            const auto b_low = b & 0xFFFFFFFFull;
+            const auto middle = (a_low * b_low >> 32) + (a_high * b_low & 0xFFFFFFFFull) + a_low * b_high;
+            const auto high = a_high * b_high + (a_high * b_low >> 32) + (middle >> 32);
+            a *= b;
+            b = high;
+#endif
+        }
+
+        /// Multiply two words into 128 bits and fold the halves together
+        inline auto multiply_fold(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t
+        {
+            multiply(a, b);
+            return a ^ b;
+        }
+
+        /// Read bytes as a little-endian word, so that hashes do not depend on the host building the table
+        template <typename Word>
+        inline auto read_word(const char* bytes) noexcept -> std::uint64_t
+        {
+            Word word{};
+            std::memcpy(&word, bytes, sizeof(word));
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                Word swapped{ 0 };
+                for (std::size_t i = 0; i < sizeof(word); ++i, word >>= 8)
+                {
+                    swapped = static_cast<Word>(swapped << 8 | (word & 0xFF));
+                }
+
+                word = swapped;
+            }
+
+            return word;
+        }
+
+        /// Ask the processor to start loading the cache line of an address
+        inline void prefetch_address(const void* address) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(address);
+#elif defined(_M_X64) || defined(_M_IX86)
+            _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+            static_cast<void>(address);
+#endif
+        }
+
+        /// Average number of identifiers per perfect hash bucket
+        constexpr std::size_t perfect_hash_bucket_size = 4;
+
+        /// Upper bound on the displacements tried for a single bucket
+        constexpr std::uint32_t perfect_hash_max_displacement = 1u << 24;
+
+        /// Map a 32-bit value onto [0, size) without a division
+        constexpr auto reduce(std::uint32_t value, std::size_t size) noexcept -> std::size_t
+        {
+            return static_cast<std::size_t>((static_cast<std::uint64_t>(value) * size) >> 32);
+        }
+
+        /// Select the perfect hash bucket of an identifier hash
+        constexpr auto perfect_hash_bucket(std::uint64_t hash, std::size_t bucket_count) noexcept -> std::size_t
+        {
+            return reduce(static_cast<std::uint32_t>(hash >> 32), bucket_count);
+        }
+
+        /// Select the perfect hash slot of an identifier hash for a bucket displacement
+        constexpr auto perfect_hash_slot(std::uint64_t hash, std::uint32_t displacement, std::size_t slot_count) noexcept -> std::size_t
+        {
+            auto mixed = hash ^ (displacement * 0x9E3779B97F4A7C15ull);
+            mixed ^= mixed >> 33;
+            mixed *= 0xFF51AFD7ED558CCDull;
+            mixed ^= mixed >> 33;
+            return reduce(static_cast<std::uint32_t>(mixed), slot_count);
+        }
+    } // namespace
+
+    auto hash_identifier(std::string_view identifier) noexcept -> std::uint64_t
+    {
+        // Word-wise multiply-fold hash in the style of wyhash: a 16-byte block
+        // costs one 64x64->128-bit multiplication, and longer identifiers run
+        // three independent chains
+        const auto* bytes = identifier.data();
+        const auto length = identifier.size();
+        auto seed = hash_secret[0];
+        std::uint64_t a = 0;
+        std::uint64_t b = 0;
+
+        if (length <= 16)
+        {
+            // Short identifiers are read as overlapping words, without a loop
+            if (length >= 4)
+            {
+                const auto shift = (length >> 3) << 2;
+                a = read_word<std::uint32_t>(bytes) << 32 | read_word<std::uint32_t>(bytes + shift);
+                b = read_word<std::uint32_t>(bytes + length - 4) << 32 | read_word<std::uint32_t>(bytes + length - 4 - shift);
+            }
+            else if (length > 0)
+            {
+                a = static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[0])) << 16 |
+                    static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[length >> 1])) << 8 | static_cast<unsigned char>(bytes[length - 1]);
+            }
+        }
+        else
+        {
+            auto remaining = length;
+            if (remaining > 48)
+            {
+                auto second = seed;
+                auto third = seed;
+                do
+                {
+                    seed = multiply_fold(read_word<std::uint64_t>(bytes) ^ hash_secret[1], read_word<std::uint64_t>(bytes + 8) ^ seed);
+                    second = multiply_fold(read_word<std::uint64_t>(bytes + 16) ^ hash_secret[2], read_word<std::uint64_t>(bytes + 24) ^ second);
+                    third = multiply_fold(read_word<std::uint64_t>(bytes + 32) ^ hash_secret[3], read_word<std::uint64_t>(bytes + 40) ^ third);
+                    bytes += 48;
+                    remaining -= 48;
+                } while (remaining > 48);
+
+                seed ^= second ^ third;
+            }
+
+            for (; remaining > 16; bytes += 16, remaining -= 16)
+            {
+                seed = multiply_fold(read_word<std::uint64_t>(bytes) ^ hash_secret[1], read_word<std::uint64_t>(bytes + 8) ^ seed);
+            }
+
+            // The last 16 bytes, overlapping the previous block
+            a = read_word<std::uint64_t>(bytes + remaining - 16);
+            b = read_word<std::uint64_t>(bytes + remaining - 8);
+        }
+
+        a ^= hash_secret[1];
+        b ^= seed;
+        multiply(a, b);
+        return multiply_fold(a ^ hash_secret[0] ^ length, b ^ hash_secret[1]);
+    }
+
+    void hash_identifiers(std::span<const std::string_view> identifiers, std::span<std::uint64_t> hashes) noexcept
+    {
+        for (std::size_t i = 0; i < identifiers.size(); ++i)
+        {
+            hashes[i] = hash_identifier(identifiers[i]);
+        }
+    }
+
+    translation_table::translation_table(const table_data& data) noexcept : data_(data)
+    {
+    }
+
+    auto translation_table::find(std::string_view identifier) const noexcept -> std::uint32_t
+    {
+        if (data_.index.empty())
+        {
+            return npos;
+        }
+
+        return find(identifier, hash_identifier(identifier));
+    }
+
+    auto translation_table::find(std::string_view identifier, std::uint64_t hash) const noexcept -> std::uint32_t
+    {
+        const auto& index = data_.index;
+        if (index.empty())
+        {
+            return npos;
+        }
+
+        const auto tag = static_cast<std::uint32_t>(hash >> 32);
+
+        if (!data_.displacements.empty())
+        {
+            const auto displacement = data_.displacements[perfect_hash_bucket(hash, data_.displacements.size())];
+            const auto& entry = index[perfect_hash_slot(hash, displacement, index.size())];
+            if (entry.tag == tag && string_at(data_.keys[entry.row]) == identifier)
+            {
+                return entry.row;
+            }
+
+            return npos;
+        }
+
+        const auto mask = index.size() - 1;
+
+        for (auto position = static_cast<std::size_t>(hash) & mask;; position = (position + 1) & mask)
+        {
+            const auto& entry = index[position];
+            if (entry.row == npos)
+            {
+                return npos;
+            }
+
+            if (entry.tag == tag && string_at(data_.keys[entry.row]) == identifier)
+            {
+                return entry.row;
+            }
+        }
+    }
+
+    void translation_table::prefetch(std::uint64_t hash) const noexcept
+    {
+        const auto& index = data_.index;
+        if (index.empty())
+        {
+            return;
+        }
+
+        // The perfect hash slot depends on the displacement, which is loaded first
+        if (!data_.displacements.empty())
+        {
+            prefetch_address(&data_.displacements[perfect_hash_bucket(hash, data_.displacements.size())]);
+            return;
+        }
+
+        prefetch_address(&index[static_cast<std::size_t>(hash) & (index.size() - 1)]);
+    }
+
+    void translation_table::prefetch_row(std::uint32_t row) const noexcept
+    {
+        prefetch_address(data_.matrix.data() + static_cast<std::size_t>(row) * data_.locales.size());
+    }
+
+    auto translation_table::find_locale(std::string_view locale) const noexcept -> std::optional<locale_id>
+    {
+        for (std::size_t i = 0; i < data_.locales.size(); ++i)
+        {
+            if (string_at(data_.locales[i]) == locale)
+            {
+                return static_cast<locale_id>(i);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    auto translation_table::text(std::uint32_t row, locale_id locale) const noexcept -> std::optional<std::string_view>
+    {
+        if (locale >= data_.locales.size())
+        {
+            return std::nullopt;
+        }
+
+        const auto offset = data_.matrix[static_cast<std::size_t>(row) * data_.locales.size() + locale];
+        if (offset == npos)
+        {
+            return std::nullopt;
+        }
+
+        return string_at(offset);
+    }
+
+    auto translation_table::first_text(std::uint32_t row) const noexcept -> std::optional<std::string_view>
+    {
+        const auto* cells = data_.matrix.data() + static_cast<std::size_t>(row) * data_.locales.size();
+        for (std::size_t i = 0; i < data_.locales.size(); ++i)
+        {
+            if (cells[i] != npos)
+            {
+                return string_at(cells[i]);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    auto translation_table::find_message(std::string_view text) const noexcept -> std::optional<message>
+    {
+        // Translations are views into the arena, so their address tells which table holds them
+        const auto* arena = data_.arena.data();
+        if (std::less<>{}(text.data(), arena) || !std::less<>{}(text.data(), arena + data_.arena.size()))
+        {
+            return std::nullopt;
+        }
+
+        const auto offset = static_cast<std::uint32_t>(text.data() - arena - sizeof(std::uint32_t));
+        const auto& messages = data_.messages;
+        const auto slot = std::lower_bound(messages.begin(), messages.end(), offset, [](const auto& entry, auto value) { return entry.text < value; });
+        if (slot == messages.end() || slot->text != offset)
+        {
+            return message(text, {});
+        }
+
+        const auto last = slot + 1 == messages.end() ? data_.message_ops.size() : (slot + 1)->first;
+        return message(text, data_.message_ops.subspan(slot->first, last - slot->first));
+    }
+
+    auto translation_table::locale(locale_id locale) const noexcept -> std::string_view
+    {
+        return string_at(data_.locales[locale]);
+    }
+
+    auto translation_table::translated_count(locale_id locale) const noexcept -> std::size_t
+    {
+        const auto stride = data_.locales.size();
+        if (locale >= stride)
+        {
+            return 0;
+        }
+
+        if (!data_.counts.empty())
+        {
+            return data_.counts[locale];
+        }
+
+        std::size_t count = 0;
+        for (std::size_t cell = locale; cell < data_.matrix.size(); cell += stride)
+        {
+            count += data_.matrix[cell] != npos ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    auto translation_table::locale_count() const noexcept -> std::size_t
+    {
+        return data_.locales.size();
+    }
+
+    auto translation_table::size() const noexcept -> std::size_t
+    {
+        return data_.keys.size();
+    }
+
+    auto translation_table::empty() const noexcept -> bool
+    {
+        return data_.keys.empty();
+    }
+
+    auto translation_table::memory_usage() const noexcept -> std::size_t
+    {
+        return storage_ ? storage_->size : 0;
+    }
+
+    auto translation_table::data() const noexcept -> const table_data&
+    {
+        return data_;
+    }
+
+    auto translation_table::string_at(std::uint32_t offset) const noexcept -> std::string_view
+    {
+        std::uint32_t length{};
+        std::memcpy(&length, data_.arena.data() + offset, sizeof(length));
+        return { data_.arena.data() + offset + sizeof(length), length };
+    }
+
+    void translation_table::builder::build_open_addressing_index(sections& output) const
+    {
+        // Build the identifier index with a load factor of at most one half
+        if (rows_.empty())
+        {
+            return;
+        }
+
+        output.index.resize(std::bit_ceil(rows_.size() * 2));
+        const auto mask = output.index.size() - 1;
+
+        for (const auto& [identifier, row] : rows_)
+        {
+            const auto hash = hash_identifier(identifier);
+            auto position = static_cast<std::size_t>(hash) & mask;
+            while (output.index[position].row != npos)
+            {
+                position = (position + 1) & mask;
+            }
+
+            output.index[position] = { static_cast<std::uint32_t>(hash >> 32), row };
+        }
+    }
+
+    void translation_table::builder::build_perfect_hash_index(sections& output) const
+    {
+        // Hash and displace: identifiers are grouped into buckets, and each
+        // bucket searches for a displacement that places all of its identifiers
+        // into free slots. Larger buckets are placed first, while most slots
+        // are still free.
+        if (rows_.empty())
+        {
+            return;
+        }
+
+        struct candidate
+        {
+            std::uint64_t hash;
+            std::uint32_t row;
+        };
+
+        const auto slot_count = rows_.size();
+        const auto bucket_count = (slot_count + perfect_hash_bucket_size - 1) / perfect_hash_bucket_size;
+
+        std::vector<std::vector<candidate>> buckets(bucket_count);
+        for (const auto& [identifier, row] : rows_)
+        {
+            const auto hash = hash_identifier(identifier);
+            buckets[perfect_hash_bucket(hash, bucket_count)].push_back({ hash, row });
+        }
+
+        std::vector<std::uint32_t> order(bucket_count);
+        for (std::uint32_t i = 0; i < bucket_count; ++i)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&buckets](auto lhs, auto rhs) { return buckets[lhs].size() > buckets[rhs].size(); });
+
+        output.index.assign(slot_count, table_slot{});
+        output.displacements.assign(bucket_count, 0);
+
+        std::vector<std::size_t> slots;
+        for (const auto bucket : order)
+        {
+            const auto& members = buckets[bucket];
+            if (members.empty())
+            {
+                break;
+            }
+
+            std::uint32_t displacement = 0;
+            for (;; ++displacement)
+            {
+                if (displacement == perfect_hash_max_displacement)
+                {
+                    throw std::runtime_error("perfect hash construction failed");
+                }
+
+                slots.clear();
+                for (const auto& member : members)
+                {
+                    const auto slot = perfect_hash_slot(member.hash, displacement, slot_count);
+                    if (output.index[slot].row != npos || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                    {
+                        break;
+                    }
+
+                    slots.push_back(slot);
+                }
+
+                if (slots.size() == members.size())
+                {
+                    break;
+                }
+            }
+
+            output.displacements[bucket] = displacement;
+            for (std::size_t i = 0; i < members.size(); ++i)
+            {
+                output.index[slots[i]] = { static_cast<std::uint32_t>(members[i].hash >> 32), members[i].row };
+            }
+        }
+    }
+
+    void translation_table::builder::build_messages(sections& output)
+    {
+        // Translations are interned, so each distinct one is compiled once, in arena order
+        std::string error;
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < output.strings.size(); offset += sizeof(std::uint32_t) + output.strings[i++].size() + 1)
+        {
+            const auto text = output.strings[i];
+            if (i < output.names || text.find_first_of("{'") == std::string_view::npos)
+            {
+                continue;
+            }
+
+            // Malformed messages and texts that compile to themselves are kept as plain text
+            const auto first = output.message_ops.size();
+            if (!compile_message(text, output.message_ops, error))
+            {
+                continue;
+            }
+
+            const auto& op = output.message_ops[first];
+            if (output.message_ops.size() - first == 1 && op.code == message_opcode::text && op.size == text.size())
+            {
+                output.message_ops.resize(first);
+                continue;
+            }
+
+            if (output.message_ops.size() >= npos)
+            {
+                throw std::length_error("compiled messages exceed 4 GiB");
+            }
+
+            output.messages.push_back({ static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(first) });
+        }
+    }
+
+    auto translation_table::builder::pack(const sections& input, std::pmr::memory_resource* resource) -> translation_table
+    {
+        // Place each section after the previous one, aligned for its element type, and the arena last
+        std::size_t size = 0;
+        const auto place = [&size]<typename T>(const std::vector<T>& section)
+        {
+            size = (size + alignof(T) - 1) / alignof(T) * alignof(T);
+            const auto offset = size;
+            size += section.size() * sizeof(T);
+            return offset;
+        };
+
+        const std::array offsets = { place(input.locales), place(input.keys), place(input.index), place(input.matrix), place(input.displacements),
+            place(input.message_ops), place(input.messages), place(input.counts) };
+        const auto arena_offset = size;
+        size += input.arena_size;
+        if (input.arena_size == 0)
+        {
+            return {};
+        }
+
+        // The control block is taken from the same resource, so a table owns no other allocation
+        auto storage = std::allocate_shared<translation_table::storage>(std::pmr::polymorphic_allocator<translation_table::storage>(resource), resource, size);
+        auto* block = static_cast<char*>(storage->block);
+        const auto copy = [block]<typename T>(const std::vector<T>& section, std::size_t offset) -> std::span<const T>
+        {
+            if (section.empty())
+            {
+                return {};
+            }
+
+            std::memcpy(block + offset, section.data(), section.size() * sizeof(T));
+            return { reinterpret_cast<const T*>(block + offset), section.size() };
+        };
+
+        // Write each length-prefixed, null-terminated string of the arena
+        auto* arena = block + arena_offset;
+        for (const auto value : input.strings)
+        {
+            const auto length = static_cast<std::uint32_t>(value.size());
+            std::memcpy(arena, &length, sizeof(length));
+            std::memcpy(arena + sizeof(length), value.data(), value.size());
+            arena[sizeof(length) + value.size()] = '\0';
+            arena += sizeof(length) + value.size() + 1;
+        }
+
+        translation_table table({ { block + arena_offset, input.arena_size }, copy(input.locales, offsets[0]), copy(input.keys, offsets[1]),
+            copy(input.index, offsets[2]), copy(input.matrix, offsets[3]), copy(input.displacements, offsets[4]), copy(input.message_ops, offsets[5]),
+            copy(input.messages, offsets[6]), copy(input.counts, offsets[7]) });
+        table.storage_ = std::move(storage);
+        return table;
+    }
+
+    translation_table::builder::builder(std::pmr::memory_resource* resource) : rows_(resource), locales_(resource)
+    {
+    }
+
+    void translation_table::builder::add(std::string_view identifier, std::string_view locale, std::string_view text)
+    {
+        auto row = rows_.find(identifier);
+        if (row == rows_.end())
+        {
+            if (rows_.size() >= npos)
+            {
+                throw std::length_error("too many translation identifiers");
+            }
+
+            row = rows_.emplace(identifier, static_cast<std::uint32_t>(rows_.size())).first;
+        }
+
+        auto id = locales_.find(locale);
+        if (id == locales_.end())
+        {
+            if (locales_.size() > std::numeric_limits<locale_id>::max())
+            {
+                throw std::length_error("too many locales");
+            }
+
+            id = locales_.emplace(locale, static_cast<locale_id>(locales_.size())).first;
+        }
+
+        // Texts are staged in one buffer rather than one string per entry
+        if (texts_.size() + text.size() >= npos)
+        {
+            throw std::length_error("translation texts exceed 4 GiB");
+        }
+
+        entries_.push_back({ row->second, static_cast<std::uint32_t>(texts_.size()), static_cast<std::uint32_t>(text.size()), id->second });
+        texts_.append(text);
+    }
+
+    auto translation_table::builder::build(table_index index, std::pmr::memory_resource* resource) const -> translation_table
+    {
+        sections staged;
+
+        // Lay out a length-prefixed, null-terminated string in the arena
+        auto append = [&staged](std::string_view value) -> std::uint32_t
+        {
+            const auto offset = staged.arena_size;
+            if (offset + sizeof(std::uint32_t) + value.size() + 1 >= npos)
+            {
+                throw std::length_error("translation arena exceeds 4 GiB");
+            }
+
+            staged.strings.push_back(value);
+            staged.arena_size += sizeof(std::uint32_t) + value.size() + 1;
+            return static_cast<std::uint32_t>(offset);
+        };
+
+        const auto row_count = rows_.size();
+        const auto locale_count = locales_.size();
+        staged.strings.reserve(row_count + locale_count + entries_.size());
+
+        staged.locales.resize(locale_count);
+        for (const auto& [locale, id] : locales_)
+        {
+            staged.locales[id] = append(locale);
+        }
+
+        staged.keys.resize(row_count);
+        for (const auto& [identifier, row] : rows_)
+        {
+            staged.keys[row] = append(identifier);
+        }
+
+        staged.names = staged.strings.size();
+
+        // Select the latest entry for each cell, then intern the surviving texts
+        staged.matrix.assign(row_count * locale_count, npos);
+        for (std::size_t i = 0; i < entries_.size(); ++i)
+        {
+            staged.matrix[static_cast<std::size_t>(entries_[i].row) * locale_count + entries_[i].locale] = static_cast<std::uint32_t>(i);
+        }
+
+        // Counted once here, so that registries of loaded tables never scan the matrix
+        staged.counts.assign(locale_count, 0);
+        for (std::size_t row = 0; row < row_count; ++row)
+        {
+            for (std::size_t locale = 0; locale < locale_count; ++locale)
+            {
+                staged.counts[locale] += staged.matrix[row * locale_count + locale] != npos ? 1 : 0;
+            }
+        }
+
+        // Interned texts are found through a flat open-addressing set of
+        // strings, avoiding one hash node per distinct text, and released
+        // before the remaining sections are built
+        {
+            struct interned_text
+            {
+                std::uint32_t string{ npos };
+                std::uint32_t offset{ npos };
+            };
+
+            std::vector<interned_text> interned(std::bit_ceil(std::max<std::size_t>(entries_.size() * 2, 1)));
+            const auto mask = interned.size() - 1;
+            for (auto& cell : staged.matrix)
+            {
+                if (cell == npos)
+                {
+                    continue;
+                }
+
+                const auto text = std::string_view(texts_).substr(entries_[cell].offset, entries_[cell].size);
+                auto position = static_cast<std::size_t>(hash_identifier(text)) & mask;
+                for (;; position = (position + 1) & mask)
+                {
+                    auto& slot = interned[position];
+                    if (slot.string == npos)
+                    {
+                        slot = { static_cast<std::uint32_t>(staged.strings.size()), append(text) };
+                        break;
+                    }
+
+                    if (staged.strings[slot.string] == text)
+                    {
+                        break;
+                    }
+                }
+
+                cell = interned[position].offset;
+            }
+        }
+
+        if (index == table_index::perfect_hash)
+        {
+            build_perfect_hash_index(staged);
+        }
+        else
+        {
+            build_open_addressing_index(staged);
+        }
+
+        build_messages(staged);
+
+        return pack(staged, resource);
+    }
+
+} // namespace linguist
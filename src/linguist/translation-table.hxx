@@ -0,0 +1,318 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#pragma once
+
+#include "linguist/message-format.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace linguist
+{
+    /// Dense identifier of an interned locale code
+    using locale_id = std::uint16_t;
+
+    /// Transparent string hash enabling heterogeneous lookup
+    ///
+    /// Allows maps keyed by std::string to be searched with std::string_view or
+    /// const char* without constructing a temporary std::string.
+    ///
+    struct string_hash
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] auto operator()(std::string_view value) const noexcept -> std::size_t
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    /// Hash a translation identifier
+    ///
+    /// The identifier is read eight bytes at a time, so dotted identifiers
+    /// sharing long prefixes hash in a few multiplications. Words are read as
+    /// little-endian, so tables built on one host index the same on any other.
+    ///
+    /// \param identifier Translation identifier/key
+    /// \return 64-bit hash of the identifier, whose high and low bits both depend on every byte
+    [[nodiscard]] auto hash_identifier(std::string_view identifier) noexcept -> std::uint64_t;
+
+    /// Hash several translation identifiers
+    ///
+    /// The hashes do not depend on each other, so the processor overlaps
+    /// their multiplications across identifiers.
+    ///
+    /// \param identifiers Translation identifiers/keys
+    /// \param hashes Receives hash_identifier() of each identifier, and must be at least as large as identifiers
+    void hash_identifiers(std::span<const std::string_view> identifiers, std::span<std::uint64_t> hashes) noexcept;
+
+    /// Slot of the open-addressing identifier index
+    struct table_slot
+    {
+        std::uint32_t tag{ 0 };
+        std::uint32_t row{ 0xFFFFFFFF };
+    };
+
+    /// Compiled message of a translation holding placeholders
+    struct message_slot
+    {
+        /// Arena offset of the translation
+        std::uint32_t text{ 0 };
+
+        /// Index of the message's first operation; it ends where the next slot's begins
+        std::uint32_t first{ 0 };
+    };
+
+    /// Sections of a translation table
+    ///
+    /// The sections either point into storage owned by a translation_table or
+    /// into constant data generated by linguist-embed-tool.
+    ///
+    struct table_data
+    {
+        /// Length-prefixed, null-terminated strings
+        std::span<const char> arena;
+
+        /// Arena offset of each locale code, indexed by locale_id
+        std::span<const std::uint32_t> locales;
+
+        /// Arena offset of each identifier, indexed by row
+        std::span<const std::uint32_t> keys;
+
+        /// Identifier index: open-addressing with a power-of-two size, or one slot
+        /// per identifier when displacements are present
+        std::span<const table_slot> index;
+
+        /// Arena offset of each translation, indexed by row * locale count + locale_id
+        std::span<const std::uint32_t> matrix;
+
+        /// Per-bucket displacements of a minimal perfect hash index, or empty
+        std::span<const std::uint32_t> displacements;
+
+        /// Operations of every compiled message, back to back
+        std::span<const message_op> message_ops;
+
+        /// Compiled message of each translation holding placeholders, sorted by arena offset
+        std::span<const message_slot> messages;
+
+        /// Number of identifiers translated into each locale, indexed by locale_id, or empty to count them from the matrix
+        std::span<const std::uint32_t> counts;
+    };
+
+    /// Layout of a translation table's identifier index
+    enum class table_index
+    {
+        /// Open-addressing hash table with linear probing
+        open_addressing,
+
+        /// Minimal perfect hash (hash and displace), with exactly one slot per identifier
+        perfect_hash,
+    };
+
+    /// Flat, interned storage for translations
+    ///
+    /// All identifiers, locale codes and translated strings live in a single
+    /// contiguous arena. Locale codes are interned into dense locale_id values,
+    /// identifiers are found through an open-addressing index, and translations
+    /// are located through a [identifier x locale] matrix of arena offsets.
+    /// Translations holding placeholders are compiled into messages when the
+    /// table is built. Every section of a built table shares one allocation,
+    /// so releasing a table frees a single block.
+    ///
+    class translation_table
+    {
+    public:
+        class builder;
+
+        /// Sentinel for a missing row or arena offset
+        static constexpr std::uint32_t npos = 0xFFFFFFFF;
+
+        /// Construct an empty table
+        translation_table() = default;
+
+        /// Construct a table viewing existing sections
+        ///
+        /// The sections are not copied and must outlive the table.
+        ///
+        /// \param data Table sections
+        explicit translation_table(const table_data& data) noexcept;
+
+        /// Find the row of an identifier
+        ///
+        /// \param identifier Translation identifier/key
+        /// \return Row of the identifier, or npos if it is not present
+        [[nodiscard]] auto find(std::string_view identifier) const noexcept -> std::uint32_t;
+
+        /// Find the row of an identifier whose hash is already known
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param hash Result of hash_identifier(identifier)
+        /// \return Row of the identifier, or npos if it is not present
+        [[nodiscard]] auto find(std::string_view identifier, std::uint64_t hash) const noexcept -> std::uint32_t;
+
+        /// Start loading the index entry of an identifier about to be found
+        ///
+        /// \param hash Result of hash_identifier(identifier)
+        void prefetch(std::uint64_t hash) const noexcept;
+
+        /// Start loading the translations of a row about to be read
+        ///
+        /// \param row Row returned by find()
+        void prefetch_row(std::uint32_t row) const noexcept;
+
+        /// Find the identifier of a locale code
+        ///
+        /// \param locale Locale code
+        /// \return Identifier of the locale if it is present
+        [[nodiscard]] auto find_locale(std::string_view locale) const noexcept -> std::optional<locale_id>;
+
+        /// Get the translation of a row for a locale
+        ///
+        /// \param row Row returned by find()
+        /// \param locale Locale identifier
+        /// \return Translated string if present
+        [[nodiscard]] auto text(std::uint32_t row, locale_id locale) const noexcept -> std::optional<std::string_view>;
+
+        /// Get the translation of a row in the first locale that has one
+        ///
+        /// \param row Row returned by find()
+        /// \return Translated string if the row has any translation
+        [[nodiscard]] auto first_text(std::uint32_t row) const noexcept -> std::optional<std::string_view>;
+
+        /// Get the compiled message of a translation
+        ///
+        /// \param text Translation returned by text() or first_text() of any table
+        /// \return Message of the translation, without operations if it is plain text,
+        ///         or std::nullopt if the translation is not held by this table
+        [[nodiscard]] auto find_message(std::string_view text) const noexcept -> std::optional<message>;
+
+        /// Get the code of an interned locale
+        ///
+        /// \param locale Locale identifier
+        /// \return Locale code
+        [[nodiscard]] auto locale(locale_id locale) const noexcept -> std::string_view;
+
+        /// Count the identifiers translated into a locale
+        ///
+        /// Built tables and binary catalogs store the counts, so this only scans
+        /// the matrix of tables whose sections lack them.
+        ///
+        /// \param locale Locale identifier
+        /// \return Number of rows holding a translation for the locale
+        [[nodiscard]] auto translated_count(locale_id locale) const noexcept -> std::size_t;
+
+        /// Get the number of interned locales
+        ///
+        /// \return Number of locales
+        [[nodiscard]] auto locale_count() const noexcept -> std::size_t;
+
+        /// Get the number of identifiers
+        ///
+        /// \return Number of rows
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+        /// Check whether the table holds no identifiers
+        ///
+        /// \return true if the table is empty
+        [[nodiscard]] auto empty() const noexcept -> bool;
+
+        /// Get the number of heap bytes owned by the table
+        ///
+        /// \return Size of the block holding the table's sections, or zero for a view
+        [[nodiscard]] auto memory_usage() const noexcept -> std::size_t;
+
+        /// Get the sections of the table
+        ///
+        /// \return Table sections
+        [[nodiscard]] auto data() const noexcept -> const table_data&;
+
+    private:
+        struct storage;
+        struct sections;
+
+        /// Read a length-prefixed string from the arena
+        [[nodiscard]] auto string_at(std::uint32_t offset) const noexcept -> std::string_view;
+
+    private:
+        table_data data_;
+        std::shared_ptr<const storage> storage_;
+    };
+
+    /// Incremental builder for a translation_table
+    ///
+    /// Identifiers and locale codes are staged in a node per distinct value until
+    /// the table is built. Giving the builder a monotonic memory resource serves
+    /// the nodes from a few large blocks, released at once with the resource.
+    ///
+    class translation_table::builder
+    {
+    public:
+        /// Construct a builder allocating from the default memory resource
+        builder() = default;
+
+        /// Construct a builder allocating from a memory resource
+        ///
+        /// \param resource Memory resource of the staged identifiers and locale codes, which must outlive the builder
+        explicit builder(std::pmr::memory_resource* resource);
+
+        /// Add a translation
+        ///
+        /// Adding a translation for an identifier and locale that already exist
+        /// replaces the previous translation.
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param locale Locale code
+        /// \param text Translated string
+        void add(std::string_view identifier, std::string_view locale, std::string_view text);
+
+        /// Build the table
+        ///
+        /// A perfect hash index costs more to build but resolves every lookup
+        /// with one hash, one displacement read and one string compare.
+        ///
+        /// \param index Layout of the identifier index
+        /// \param resource Memory resource of the table's block, which must outlive the table
+        /// \return Table holding every added translation
+        [[nodiscard]] auto build(table_index index = table_index::open_addressing,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const -> translation_table;
+
+    private:
+        /// Build an open-addressing identifier index
+        void build_open_addressing_index(sections& output) const;
+
+        /// Build a minimal perfect hash identifier index
+        void build_perfect_hash_index(sections& output) const;
+
+        /// Compile the translations holding placeholders into messages
+        static void build_messages(sections& output);
+
+        /// Write the laid-out arena and the other sections into one block of a memory resource
+        [[nodiscard]] static auto pack(const sections& input, std::pmr::memory_resource* resource) -> translation_table;
+
+    private:
+        struct entry
+        {
+            std::uint32_t row;
+            std::uint32_t offset;
+            std::uint32_t size;
+            locale_id locale;
+        };
+
+        std::pmr::unordered_map<std::pmr::string, std::uint32_t, string_hash, std::equal_to<>> rows_;
+        std::pmr::unordered_map<std::pmr::string, locale_id, string_hash, std::equal_to<>> locales_;
+        std::vector<entry> entries_;
+        std::string texts_;
+    };
+
+} // namespace linguist
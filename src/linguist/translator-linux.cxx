@@ -8,8 +8,17 @@ namespace linguist
 {
     auto translator::detect_system_locale() -> std::string
     {
-        // Linux/Unix
-        if (const char* lang = std::getenv("LANG"); lang)
+        // Linux/Unix: the first of LC_ALL, LC_MESSAGES and LANG that is set decides the language of messages
+        const char* lang = nullptr;
+        for (const char* variable : { "LC_ALL", "LC_MESSAGES", "LANG" })
+        {
+            if (lang = std::getenv(variable); lang && *lang)
+            {
+                break;
+            }
+        }
+
+        if (lang && *lang)
         {
             std::string locale(lang);
 
@@ -17,8 +26,8 @@ namespace linguist
             locale.erase(0, locale.find_first_not_of(" \t\n\r"));
             locale.erase(locale.find_last_not_of(" \t\n\r") + 1);
 
-            // Extract locale from formats like "en_US.UTF-8"
-            const size_t dot_position = locale.find('.');
+            // Extract locale from formats like "en_US.UTF-8" or "de_DE@euro"
+            const size_t dot_position = locale.find_first_of(".@");
             if (dot_position != std::string::npos)
             {
                 locale = locale.substr(0, dot_position);
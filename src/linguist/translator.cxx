@@ -4,11 +4,10 @@
 
 #include "linguist/translator.hxx"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
-#include <fstream>
 #include <locale>
-#include <sstream>
-#include <nlohmann/json.hpp>
 
 namespace linguist
 {
@@ -17,27 +16,229 @@ namespace linguist
         load_embedded();
     }
 
+    translator::translator(background_load_t) : current_locale_(detect_system_locale())
+    {
+        // Serve lookups from an empty catalog, so that they return their fallback until the embedded translations are published
+        publish({});
+        (void)load_async([](std::string&) -> std::optional<catalog> { return catalog::embedded(); });
+    }
+
+    translator::translator(catalog translations) : current_locale_(detect_system_locale())
+    {
+        publish(translations);
+    }
+
+    translator::~translator()
+    {
+        // Background loads publish into this translator
+        wait_for_loads();
+    }
+
+    translator::translator(translator&& other)
+    {
+        *this = std::move(other);
+    }
+
+    auto translator::operator=(translator&& other) -> translator&
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        // Background loads publish into the translator that started them
+        wait_for_loads();
+        other.wait_for_loads();
+
+        current_locale_ = std::move(other.current_locale_);
+        default_locale_ = std::move(other.default_locale_);
+        load_error_ = std::move(other.load_error_);
+        statistics_ = std::move(other.statistics_);
+        state_.store(other.state_.load());
+        return *this;
+    }
+
     auto translator::load_embedded() -> void
     {
-        translations_ = get_embedded_translations();
+        // Translators constructed for the same system locale share their snapshot of the embedded translations
+        static const std::string system_locale = current_locale_;
+        static const auto system_snapshot = catalog::embedded().resolve(system_locale, {});
+        if (current_locale_ == system_locale && default_locale_.empty() && !statistics_)
+        {
+            state_.store(system_snapshot);
+            return;
+        }
+
+        publish(catalog::embedded());
+    }
+
+    auto translator::begin_load() -> std::uint64_t
+    {
+        std::lock_guard lock(publish_mutex_);
+        return ++loads_started_;
     }
 
-    auto translator::load_from_string(const std::string& json_content) -> bool
+    auto translator::finish_load(std::uint64_t load, std::optional<catalog> translations, std::string error) -> bool
     {
-        try
+        std::lock_guard lock(publish_mutex_);
+
+        // A load started later was published while this one was still reading
+        if (load < loads_published_)
         {
-            translations_ = nlohmann::json::parse(json_content);
-            return !translations_.empty();
+            return false;
         }
-        catch (...)
+
+        if (!translations)
         {
+            load_error_ = std::move(error);
             return false;
         }
+
+        loads_published_ = load;
+        load_error_.clear();
+        publish(*translations);
+        return true;
+    }
+
+    template <typename Loader>
+    auto translator::load(Loader&& loader) -> bool
+    {
+        const auto load = begin_load();
+        std::string error;
+        auto translations = loader(error);
+        return finish_load(load, std::move(translations), std::move(error));
+    }
+
+    template <typename Loader>
+    auto translator::load_async(Loader loader) -> std::shared_future<bool>
+    {
+        const auto load = begin_load();
+        auto result = std::async(std::launch::async,
+            [this, load, loader = std::move(loader)]() -> bool
+            {
+                std::string error;
+                auto translations = loader(error);
+                return finish_load(load, std::move(translations), std::move(error));
+            })
+                          .share();
+
+        // The translator keeps a copy of the future, so that dropping the caller's copy does not wait for the load
+        std::lock_guard lock(publish_mutex_);
+        std::erase_if(background_loads_, [](const auto& pending) { return pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+        background_loads_.push_back(result);
+        return result;
+    }
+
+    auto translator::load_from_string(std::string_view json_content) -> bool
+    {
+        return load([&](std::string& error) { return catalog::from_string(json_content, error); });
+    }
+
+    auto translator::load_from_stream(std::istream& input) -> bool
+    {
+        return load([&](std::string& error) { return catalog::from_stream(input, error); });
+    }
+
+    auto translator::load_from_file(const std::filesystem::path& path) -> bool
+    {
+        return load([&](std::string& error) { return catalog::from_file(path, error); });
+    }
+
+    auto translator::load_mapped(const std::filesystem::path& path) -> bool
+    {
+        return load([&](std::string& error) { return catalog::from_mapped(path, error); });
+    }
+
+    auto translator::load_directory(const std::filesystem::path& directory, std::size_t memory_limit) -> bool
+    {
+        return load([&](std::string& error) { return catalog::from_directory(directory, memory_limit, error); });
+    }
+
+    auto translator::load_from_string_async(std::string json_content) -> std::shared_future<bool>
+    {
+        return load_async([json_content = std::move(json_content)](std::string& error) { return catalog::from_string(json_content, error); });
+    }
+
+    auto translator::load_from_file_async(std::filesystem::path path) -> std::shared_future<bool>
+    {
+        return load_async([path = std::move(path)](std::string& error) { return catalog::from_file(path, error); });
+    }
+
+    auto translator::load_mapped_async(std::filesystem::path path) -> std::shared_future<bool>
+    {
+        return load_async([path = std::move(path)](std::string& error) { return catalog::from_mapped(path, error); });
+    }
+
+    auto translator::load_directory_async(std::filesystem::path directory, std::size_t memory_limit) -> std::shared_future<bool>
+    {
+        return load_async(
+            [directory = std::move(directory), memory_limit](std::string& error) { return catalog::from_directory(directory, memory_limit, error); });
+    }
+
+    void translator::wait_for_loads() const
+    {
+        std::vector<std::shared_future<bool>> pending;
+        {
+            // Loads finish by taking the lock, so wait without it
+            std::lock_guard lock(publish_mutex_);
+            pending = background_loads_;
+        }
+
+        for (const auto& load : pending)
+        {
+            load.wait();
+        }
+    }
+
+    void translator::set_catalog(catalog translations)
+    {
+        (void)load([&](std::string&) -> std::optional<catalog> { return std::move(translations); });
+    }
+
+    auto translator::get_catalog() const -> catalog
+    {
+        return state_.load()->catalog_;
+    }
+
+    auto translator::get_loaded_locales() const -> std::vector<std::string>
+    {
+        return state_.load()->catalog_.get_loaded_locales();
+    }
+
+    auto translator::snapshot() const -> std::shared_ptr<const translation_snapshot>
+    {
+        return state_.load();
+    }
+
+    auto translator::get_load_error() const -> std::string
+    {
+        std::lock_guard lock(publish_mutex_);
+        return load_error_;
     }
 
     void translator::set_locale(const std::string& locale)
     {
+        std::lock_guard lock(publish_mutex_);
         current_locale_ = locale;
+
+        resolve_locale_chain();
+    }
+
+    auto translator::set_preferred_locales(std::string_view preferences) -> bool
+    {
+        // Room for every range of the list, so that none is dropped
+        std::vector<weighted_locale> ranges(static_cast<std::size_t>(std::count(preferences.begin(), preferences.end(), ',')) + 1);
+        const auto count = parse_locale_preferences(preferences, ranges);
+
+        const auto available = current()->catalog_.available_locales();
+        const auto index = match_locale(std::span(ranges.data(), count), available);
+        if (!index)
+        {
+            return false;
+        }
+
+        set_locale(std::string(available[*index].locale));
+        return true;
     }
 
     auto translator::get_locale() const -> const std::string&
@@ -45,39 +246,82 @@ namespace linguist
         return current_locale_;
     }
 
-    auto translator::translate(const std::string& identifier) const -> std::optional<std::string>
+    void translator::set_default_locale(const std::string& locale)
     {
-        auto it = translations_.find(identifier);
-        if (it == translations_.end())
-        {
-            return std::nullopt;
-        }
+        std::lock_guard lock(publish_mutex_);
+        default_locale_ = locale;
+
+        resolve_locale_chain();
+    }
+
+    auto translator::get_default_locale() const -> const std::string&
+    {
+        return default_locale_;
+    }
 
-        const auto& locale_map = it->second;
-        auto localeIt = locale_map.find(current_locale_);
-        if (localeIt != locale_map.end())
+    void translator::enable_statistics([[maybe_unused]] const statistics_options& options)
+    {
+#if LINGUIST_STATISTICS
+        std::lock_guard lock(publish_mutex_);
+        statistics_ = std::make_shared<lookup_statistics>(options);
+        resolve_locale_chain();
+#endif
+    }
+
+    void translator::disable_statistics()
+    {
+        std::lock_guard lock(publish_mutex_);
+        if (statistics_)
         {
-            return localeIt->second;
+            statistics_.reset();
+            resolve_locale_chain();
         }
+    }
 
-        // Try fallback to base language (e.g., "en" from "en-US")
-        const size_t dashPos = current_locale_.find('-');
-        if (dashPos != std::string::npos)
+    auto translator::get_statistics() const -> statistics_snapshot
+    {
+        // Read through the published snapshot, which other threads can load safely
+        const auto state = state_.load();
+        return state->statistics_ ? state->statistics_->snapshot() : statistics_snapshot{};
+    }
+
+    void translator::reset_statistics() const
+    {
+        if (const auto state = state_.load(); state->statistics_)
         {
-            std::string baseLocale = current_locale_.substr(0, dashPos);
-            for (const auto& [locale, translation] : locale_map)
-            {
-                if (locale.find(baseLocale) == 0)
-                {
-                    return translation;
-                }
-            }
+            state->statistics_->reset();
         }
+    }
 
-        // Return first available translation as last resort
-        if (!locale_map.empty())
+    void translator::resolve_locale_chain()
+    {
+        auto state = state_.load();
+        const auto translations = state->catalog_;
+
+        // Release the previous snapshot, so that only readers still holding it keep its locales loaded
+        state.reset();
+        publish(translations);
+    }
+
+    void translator::publish(const catalog& translations)
+    {
+        // Readers release the previous snapshot once their lookups into it finish
+        state_.store(translations.resolve(current_locale_, default_locale_, statistics_));
+
+        // Locales only referenced by the previous snapshot can now be evicted
+        translations.trim();
+    }
+
+    auto translator::current() const -> std::shared_ptr<const translation_snapshot>
+    {
+        return state_.load();
+    }
+
+    auto translator::translate(const std::string& identifier) const -> std::optional<std::string>
+    {
+        if (auto translation = current()->translate_view(identifier); translation)
         {
-            return locale_map.begin()->second;
+            return std::string(*translation);
         }
 
         return std::nullopt;
@@ -85,52 +329,129 @@ namespace linguist
 
     auto translator::translate(const std::string& identifier, const std::string& fallback) const -> std::string
     {
-        auto result = translate(identifier);
-        return result.value_or(fallback);
+        return std::string(current()->translate_view(identifier).value_or(fallback));
     }
 
     auto translator::translate(const std::string& identifier, const std::string& locale, bool) const -> std::optional<std::string>
     {
-        auto it = translations_.find(identifier);
-        if (it == translations_.end())
+        // The copy is taken while the found table is held, so that the snapshot does not keep it loaded
+        const auto state = current();
+        if (const auto found = state->find_locale_text(identifier, locale); found.text)
         {
-            return std::nullopt;
+            return std::string(*found.text);
         }
 
-        const auto& locale_map = it->second;
-        auto localeIt = locale_map.find(locale);
-        if (localeIt != locale_map.end())
+        return std::nullopt;
+    }
+
+    auto translator::translate_view(std::string_view identifier) const -> std::optional<std::string_view>
+    {
+        return current()->translate_view(identifier);
+    }
+
+    auto translator::translate_view(std::string_view identifier, std::string_view fallback) const -> std::string_view
+    {
+        return translate_view(identifier).value_or(fallback);
+    }
+
+    auto translator::translate(key_id key) const -> std::optional<std::string>
+    {
+        if (auto translation = current()->translate_view(key); translation)
         {
-            return localeIt->second;
+            return std::string(*translation);
         }
 
         return std::nullopt;
     }
 
-    auto translator::has_translation(const std::string& identifier) const -> bool
+    auto translator::translate(key_id key, std::string_view fallback) const -> std::string
     {
-        return translate(identifier).has_value();
+        return std::string(current()->translate_view(key).value_or(fallback));
     }
 
-    auto translator::get_available_locales() const -> std::vector<std::string>
+    auto translator::translate_view(key_id key) const -> std::optional<std::string_view>
+    {
+        return current()->translate_view(key);
+    }
+
+    auto translator::translate_view(key_id key, std::string_view fallback) const -> std::string_view
+    {
+        return translate_view(key).value_or(fallback);
+    }
+
+    auto translator::translate_view(std::string_view identifier, std::string_view locale, bool) const -> std::optional<std::string_view>
+    {
+        return current()->translate_view(identifier, locale, true);
+    }
+
+    void translator::translate_batch(std::span<const std::string_view> identifiers, std::span<std::optional<std::string_view>> translations) const
     {
-        std::unordered_map<std::string, bool> localeSet;
+        current()->translate_batch(identifiers, translations);
+    }
 
-        for (const auto& [identifier, locale_map] : translations_)
+    void translator::translate_batch(std::span<const key_id> keys, std::span<std::optional<std::string_view>> translations) const
+    {
+        current()->translate_batch(keys, translations);
+    }
+
+    auto translator::format_to(std::string_view identifier, std::span<char> buffer, std::span<const message_argument> arguments) const
+        -> std::optional<std::size_t>
+    {
+        const auto state = current();
+        if (auto compiled = state->find_message(identifier); compiled)
         {
-            for (const auto& [locale, translation] : locale_map)
-            {
-                localeSet[locale] = true;
-            }
+            return compiled->format_to(buffer, arguments, state->get_plural_rule());
         }
 
-        std::vector<std::string> locales;
-        locales.reserve(localeSet.size());
-        for (const auto& [locale, _] : localeSet)
+        return std::nullopt;
+    }
+
+    auto translator::format_to(key_id key, std::span<char> buffer, std::span<const message_argument> arguments) const
+        -> std::optional<std::size_t>
+    {
+        const auto state = current();
+        if (auto compiled = state->find_message(key); compiled)
         {
-            locales.push_back(locale);
+            return compiled->format_to(buffer, arguments, state->get_plural_rule());
         }
 
-        return locales;
+        return std::nullopt;
+    }
+
+    auto translator::format(std::string_view identifier, std::span<const message_argument> arguments) const -> std::optional<std::string>
+    {
+        const auto state = current();
+        if (auto compiled = state->find_message(identifier); compiled)
+        {
+            return compiled->format(arguments, state->get_plural_rule());
+        }
+
+        return std::nullopt;
+    }
+
+    auto translator::format(key_id key, std::span<const message_argument> arguments) const -> std::optional<std::string>
+    {
+        const auto state = current();
+        if (auto compiled = state->find_message(key); compiled)
+        {
+            return compiled->format(arguments, state->get_plural_rule());
+        }
+
+        return std::nullopt;
+    }
+
+    auto translator::has_translation(std::string_view identifier) const -> bool
+    {
+        return translate_view(identifier).has_value();
+    }
+
+    auto translator::get_available_locales() const -> std::vector<std::string>
+    {
+        return current()->catalog_.get_available_locales();
+    }
+
+    auto translator::available_locales() const -> std::span<const locale_info>
+    {
+        return current()->catalog_.available_locales();
     }
 } // namespace linguist
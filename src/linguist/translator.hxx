@@ -4,15 +4,35 @@
 
 #pragma once
 
+#include "linguist/atomic-shared-ptr.hxx"
+#include "linguist/catalog.hxx"
+#include "linguist/key-id.hxx"
+#include "linguist/locale-negotiation.hxx"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <istream>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 namespace linguist
 {
-    /// Generated function for embedded translations (defined by embed_translation_file)
-    [[nodiscard]] auto get_embedded_translations() -> std::unordered_map<std::string, std::unordered_map<std::string, std::string>>;
+    /// Tag constructing a translator whose embedded translations are loaded on a background thread
+    struct background_load_t
+    {
+        explicit background_load_t() = default;
+    };
+
+    /// Construct a translator whose embedded translations are loaded on a background thread
+    inline constexpr background_load_t background_load{};
 
     /// Lightweight translation library for locale-based string lookups
     ///
@@ -20,14 +40,43 @@ namespace linguist
     /// string retrieval. The JSON format uses identifiers as keys, with locale
     /// codes mapping to translated strings.
     ///
+    /// Lookups may run on any number of threads while one thread at a time
+    /// loads translations or changes locales. Each change builds a new
+    /// translation_snapshot off to the side and publishes it atomically, so
+    /// readers never block on a load and never see a partially replaced table.
+    /// Each lookup loads the current snapshot and holds it only while it
+    /// reads, so the previous translations are freed as soon as no lookup or
+    /// snapshot() holds them.
+    ///
+    /// The *_async loaders read and build translations on a background thread
+    /// and return at once, so that loading stays off the caller's startup
+    /// path. Until the load is published, lookups are served by the previous
+    /// translations, or return their fallback; the returned future, or
+    /// wait_for_loads(), waits for it.
+    ///
+    /// Servers translating for many locales at once share one catalog instead,
+    /// and give each thread or request a locale_view of it.
+    ///
     class translator
     {
     public:
         /// Construct a new translator object
         translator();
 
-        /// Destroy the translator object
-        ~translator() = default;
+        /// Construct a translator loading the embedded translations on a background thread
+        ///
+        /// Construction returns without resolving the embedded translations,
+        /// which may decompress or materialise the current locale's catalog.
+        /// Lookups return their fallback until they are published.
+        explicit translator(background_load_t);
+
+        /// Construct a translator sharing a catalog's translations
+        ///
+        /// \param translations Catalog to translate from, instead of the embedded translations
+        explicit translator(catalog translations);
+
+        /// Destroy the translator object, after waiting for its background loads
+        ~translator();
 
         /// Disable copy
         translator(const translator&) = delete;
@@ -36,28 +85,195 @@ namespace linguist
         translator& operator=(const translator&) = delete;
 
         /// Enable move
-        translator(translator&&) noexcept = default;
+        ///
+        /// Blocks until the background loads of other are published or discarded,
+        /// since they publish into other.
+        translator(translator&& other);
 
         /// Enable move
-        translator& operator=(translator&&) noexcept = default;
+        ///
+        /// Blocks until the background loads of both translators are published or
+        /// discarded, since they publish into the translator that started them.
+        /// Moving a translator into itself leaves it unchanged.
+        translator& operator=(translator&& other);
 
         /// Load translations from a JSON string
         ///
+        /// The JSON is streamed straight into the translation table without
+        /// building a document. On failure, the current translations are kept
+        /// and get_load_error() describes the error.
+        ///
         /// \param json_content JSON content as a string
         /// \return true if loaded successfully
         /// \return false if loading failed
-        [[nodiscard]] auto load_from_string(const std::string& json_content) -> bool;
+        [[nodiscard]] auto load_from_string(std::string_view json_content) -> bool;
+
+        /// Load translations from a JSON stream
+        ///
+        /// \param input Stream holding the JSON content
+        /// \return true if loaded successfully
+        /// \return false if loading failed
+        [[nodiscard]] auto load_from_stream(std::istream& input) -> bool;
+
+        /// Load translations from a JSON file
+        ///
+        /// \param path Path of the JSON file
+        /// \return true if loaded successfully
+        /// \return false if the file cannot be opened or loading failed
+        [[nodiscard]] auto load_from_file(const std::filesystem::path& path) -> bool;
+
+        /// Load translations from a binary catalog
+        ///
+        /// The catalog is memory-mapped and lookups are served directly from the
+        /// mapped pages, without parsing or copying. Catalogs are written by
+        /// linguist-embed-tool --binary; those written with --compress are
+        /// decompressed into memory instead. Every offset of the catalog is checked
+        /// once, so truncated or corrupt files are rejected. On failure, the current translations are kept.
+        ///
+        /// \param path Path of the catalog file
+        /// \return true if loaded successfully
+        /// \return false if the file cannot be mapped or is not a valid catalog
+        [[nodiscard]] auto load_mapped(const std::filesystem::path& path) -> bool;
+
+        /// Load translations split into one catalog per locale
+        ///
+        /// The directory holds a <locale>.lcat or <locale>.json catalog for each
+        /// locale, as written by linguist-embed-tool --split-locales. Catalogs are
+        /// only loaded when set_locale(), set_default_locale() or a lookup for a
+        /// specific locale first needs them. Lookups then only search the locales
+        /// of the fallback chain, never the first available translation.
+        ///
+        /// \param directory Directory holding the per-locale catalogs
+        /// \param memory_limit Bytes of loaded catalogs to keep, or 0 for no limit. Locales
+        ///        outside the fallback chain are evicted least recently used first.
+        /// \return true if the directory holds at least one catalog
+        /// \return false otherwise
+        [[nodiscard]] auto load_directory(const std::filesystem::path& directory, std::size_t memory_limit = 0) -> bool;
+
+        /// Load translations from a JSON string on a background thread
+        ///
+        /// Loads are published in the order they were started: a load that
+        /// finishes after a later one has been published is discarded. On
+        /// failure, the current translations are kept and get_load_error()
+        /// describes the error once the future is ready.
+        ///
+        /// \param json_content JSON content as a string, kept until the load finishes
+        /// \return Future becoming true once the translations are published, or false if loading failed or was superseded
+        [[nodiscard]] auto load_from_string_async(std::string json_content) -> std::shared_future<bool>;
+
+        /// Load translations from a JSON file on a background thread
+        ///
+        /// \param path Path of the JSON file
+        /// \return Future becoming true once the translations are published, or false if loading failed or was superseded
+        [[nodiscard]] auto load_from_file_async(std::filesystem::path path) -> std::shared_future<bool>;
+
+        /// Load translations from a binary catalog on a background thread
+        ///
+        /// \param path Path of the catalog file
+        /// \return Future becoming true once the translations are published, or false if loading failed or was superseded
+        [[nodiscard]] auto load_mapped_async(std::filesystem::path path) -> std::shared_future<bool>;
+
+        /// Load translations split into one catalog per locale on a background thread
+        ///
+        /// The catalogs of the current and default locales are loaded before
+        /// the translations are published, so that lookups never wait on them.
+        ///
+        /// \param directory Directory holding the per-locale catalogs
+        /// \param memory_limit Bytes of loaded catalogs to keep, or 0 for no limit
+        /// \return Future becoming true once the translations are published, or false if loading failed or was superseded
+        [[nodiscard]] auto load_directory_async(std::filesystem::path directory, std::size_t memory_limit = 0) -> std::shared_future<bool>;
+
+        /// Wait for the loads running on background threads to be published or discarded
+        ///
+        /// May be called from any thread, concurrently with lookups.
+        void wait_for_loads() const;
+
+        /// Get the locales whose translations are currently loaded
+        ///
+        /// \return List of locale codes, which is every available locale unless translations are split per locale
+        [[nodiscard]] auto get_loaded_locales() const -> std::vector<std::string>;
+
+        /// Replace the translations with a catalog's
+        ///
+        /// \param translations Catalog to translate from, whose data is shared rather than copied
+        void set_catalog(catalog translations);
+
+        /// Get the current translations
+        ///
+        /// \return Catalog sharing the translator's data
+        [[nodiscard]] auto get_catalog() const -> catalog;
+
+        /// Get the current translations and locale chain
+        ///
+        /// Hold the snapshot to keep views valid while other threads reload the translator.
+        ///
+        /// \return Snapshot published by the last load or locale change
+        [[nodiscard]] auto snapshot() const -> std::shared_ptr<const translation_snapshot>;
+
+        /// Get the error of the last failed load
+        ///
+        /// The error is copied, since loads finishing on other threads may replace it.
+        ///
+        /// \return Description of the error, or an empty string if the last load succeeded
+        [[nodiscard]] auto get_load_error() const -> std::string;
 
         /// Set the current locale
         ///
         /// \param locale Locale code (e.g., "en-US", "fr-FR")
         void set_locale(const std::string& locale);
 
+        /// Set the current locale to the best available match of a preference list
+        ///
+        /// Every range of the list is considered, however long it is.
+        ///
+        /// \param preferences Weighted locale list, such as an Accept-Language header (e.g., "fr-CH, fr;q=0.9, en;q=0.8")
+        /// \return true if a locale matched and was set
+        /// \return false if none matched, keeping the current locale
+        [[nodiscard]] auto set_preferred_locales(std::string_view preferences) -> bool;
+
         /// Get the current locale
         ///
         /// \return Current locale code
         [[nodiscard]] auto get_locale() const -> const std::string&;
 
+        /// Set the default locale
+        ///
+        /// The default locale is tried after the current locale and its base
+        /// language, and before falling back to the first available translation.
+        ///
+        /// \param locale Locale code (e.g., "en-US"), or an empty string for none
+        void set_default_locale(const std::string& locale);
+
+        /// Get the default locale
+        ///
+        /// \return Default locale code, or an empty string if none is configured
+        [[nodiscard]] auto get_default_locale() const -> const std::string&;
+
+        /// Start counting lookups
+        ///
+        /// Lookups are then counted by how they were resolved, missing
+        /// identifiers are tracked and, optionally, a sample of lookups is timed.
+        /// Counting costs a few nanoseconds per lookup while enabled, a branch
+        /// while disabled, and nothing when the library is built without
+        /// BUILD_WITH_LOOKUP_STATISTICS, in which case this does nothing.
+        /// Like set_locale(), it must not run concurrently with loads.
+        ///
+        /// \param options Missing identifiers tracked and latency sampling
+        void enable_statistics(const statistics_options& options = {});
+
+        /// Stop counting lookups, discarding the statistics collected so far
+        void disable_statistics();
+
+        /// Get the statistics collected since they were enabled or last reset
+        ///
+        /// May be called from any thread, concurrently with lookups.
+        ///
+        /// \return Lookup statistics, not enabled if they are not being collected
+        [[nodiscard]] auto get_statistics() const -> statistics_snapshot;
+
+        /// Clear the statistics collected so far, without stopping to collect them
+        void reset_statistics() const;
+
         /// Get translation for an identifier using current locale
         ///
         /// \param identifier Translation identifier/key
@@ -79,18 +295,144 @@ namespace linguist
         /// \return Translated string if found
         [[nodiscard]] auto translate(const std::string& identifier, const std::string& locale, bool) const -> std::optional<std::string>;
 
+        /// Get a view of the translation for an identifier using current locale
+        ///
+        /// The returned view refers to the translator's storage and remains valid
+        /// until the translations are reloaded or the translator is destroyed. With
+        /// translations split per locale, it is valid until the translations are
+        /// reloaded, the locale or default locale changes, or the translator is
+        /// destroyed, since the locales the previous chain used may then be evicted.
+        /// Readers racing with reloads on other threads should use snapshot() instead.
+        ///
+        /// \param identifier Translation identifier/key
+        /// \return View of the translated string if found
+        [[nodiscard]] auto translate_view(std::string_view identifier) const -> std::optional<std::string_view>;
+
+        /// Get a view of the translation for an identifier with fallback
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param fallback Fallback string if translation not found
+        /// \return View of the translated string or fallback
+        [[nodiscard]] auto translate_view(std::string_view identifier, std::string_view fallback) const -> std::string_view;
+
+        /// Get a view of the translation for a specific locale
+        ///
+        /// With translations split per locale, the locale stays loaded and the
+        /// view valid until the translations are reloaded, the locale or default
+        /// locale changes, or the translator is destroyed. translate() copies
+        /// the translation instead, and leaves the locale free to be evicted.
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param locale Locale code to use for this translation
+        /// \return View of the translated string if found
+        [[nodiscard]] auto translate_view(std::string_view identifier, std::string_view locale, bool) const -> std::optional<std::string_view>;
+
+        /// Get translation for a compile-time key using current locale
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \return Translated string if found
+        [[nodiscard]] auto translate(key_id key) const -> std::optional<std::string>;
+
+        /// Get translation for a compile-time key with fallback
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \param fallback Fallback string if translation not found
+        /// \return Translated string or fallback
+        [[nodiscard]] auto translate(key_id key, std::string_view fallback) const -> std::string;
+
+        /// Get a view of the translation for a compile-time key using current locale
+        ///
+        /// While the embedded translations are active, the key indexes the table
+        /// directly without hashing the identifier.
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \return View of the translated string if found
+        [[nodiscard]] auto translate_view(key_id key) const -> std::optional<std::string_view>;
+
+        /// Get a view of the translation for a compile-time key with fallback
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \param fallback Fallback string if translation not found
+        /// \return View of the translated string or fallback
+        [[nodiscard]] auto translate_view(key_id key, std::string_view fallback) const -> std::string_view;
+
+        /// Get views of the translations of several identifiers using current locale
+        ///
+        /// Rendering a screen or response translates its identifiers in one pass:
+        /// they are hashed together, and their index and translation reads are
+        /// prefetched a block at a time so that their cache misses overlap. The
+        /// views remain valid like those of translate_view().
+        ///
+        /// \param identifiers Translation identifiers/keys
+        /// \param translations Receives the view of each identifier's translation if found, and must be at least as large as identifiers
+        void translate_batch(std::span<const std::string_view> identifiers, std::span<std::optional<std::string_view>> translations) const;
+
+        /// Get views of the translations of several compile-time keys using current locale
+        ///
+        /// \param keys Key handles generated from the embedded translations
+        /// \param translations Receives the view of each key's translation if found, and must be at least as large as keys
+        void translate_batch(std::span<const key_id> keys, std::span<std::optional<std::string_view>> translations) const;
+
+        /// Format the message of an identifier into a buffer using current locale
+        ///
+        /// Translations may hold ICU-style placeholders, such as "{name}",
+        /// "{count, plural, one {# file} other {# files}}" and "{gender, select, ...}".
+        /// They are compiled once when translations are loaded or embedded, so
+        /// formatting neither parses the message nor allocates. Plural cases are
+        /// chosen by the rules of the current locale's language.
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param buffer Receives the formatted message, truncated if it does not fit
+        /// \param arguments Arguments of the message's placeholders
+        /// \return Size of the whole formatted message if found, which is larger than buffer if it was truncated
+        [[nodiscard]] auto format_to(std::string_view identifier, std::span<char> buffer, std::span<const message_argument> arguments) const
+            -> std::optional<std::size_t>;
+
+        /// Format the message of a compile-time key into a buffer using current locale
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \param buffer Receives the formatted message, truncated if it does not fit
+        /// \param arguments Arguments of the message's placeholders
+        /// \return Size of the whole formatted message if found, which is larger than buffer if it was truncated
+        [[nodiscard]] auto format_to(key_id key, std::span<char> buffer, std::span<const message_argument> arguments) const
+            -> std::optional<std::size_t>;
+
+        /// Format the message of an identifier using current locale
+        ///
+        /// \param identifier Translation identifier/key
+        /// \param arguments Arguments of the message's placeholders
+        /// \return Formatted message if found
+        [[nodiscard]] auto format(std::string_view identifier, std::span<const message_argument> arguments) const -> std::optional<std::string>;
+
+        /// Format the message of a compile-time key using current locale
+        ///
+        /// \param key Key handle generated from the embedded translations
+        /// \param arguments Arguments of the message's placeholders
+        /// \return Formatted message if found
+        [[nodiscard]] auto format(key_id key, std::span<const message_argument> arguments) const -> std::optional<std::string>;
+
         /// Check if a translation exists for an identifier
         ///
         /// \param identifier Translation identifier/key
         /// \return true if translation exists for current locale
         /// \return false otherwise
-        [[nodiscard]] auto has_translation(const std::string& identifier) const -> bool;
+        [[nodiscard]] auto has_translation(std::string_view identifier) const -> bool;
 
         /// Get all available locales
         ///
         /// \return List of locale codes
         [[nodiscard]] auto get_available_locales() const -> std::vector<std::string>;
 
+        /// Get the registry of available locales, with the number of identifiers translated into each
+        ///
+        /// Unlike get_available_locales(), nothing is copied: the registry is
+        /// built when translations are loaded. It remains valid until the
+        /// translations are reloaded or the translator is destroyed, like
+        /// translate_view().
+        ///
+        /// \return Each locale and its coverage, or locale_info::unknown for split compressed or JSON locales not loaded yet
+        [[nodiscard]] auto available_locales() const -> std::span<const locale_info>;
+
         /// Detect system locale automatically
         ///
         /// \return Detected locale code (e.g., "en-US")
@@ -100,12 +442,45 @@ namespace linguist
         /// Load translations from embedded data
         ///
         /// Loads translations that were embedded at build-time using embed_translation_file().
-        /// This calls the generated get_embedded_translations() function.
+        /// The generated get_embedded_translations() data is referenced in place, without copying.
+        /// Translations embedded per locale are materialised as they are needed.
         void load_embedded();
 
+        /// Read translations with a loader and activate them
+        template <typename Loader>
+        [[nodiscard]] auto load(Loader&& loader) -> bool;
+
+        /// Read translations with a loader on a background thread, then activate them
+        template <typename Loader>
+        [[nodiscard]] auto load_async(Loader loader) -> std::shared_future<bool>;
+
+        /// Number a load, so that it is published only if no later load has been
+        [[nodiscard]] auto begin_load() -> std::uint64_t;
+
+        /// Activate the translations read by a load, unless a later load was published first
+        [[nodiscard]] auto finish_load(std::uint64_t load, std::optional<catalog> translations, std::string error) -> bool;
+
+        /// Publish the current translations with the fallback chain of the current and default locales
+        void resolve_locale_chain();
+
+        /// Publish a snapshot of translations with the fallback chain of the current and default locales
+        void publish(const catalog& translations);
+
+        /// Get the current snapshot, which the caller keeps alive until it releases it
+        [[nodiscard]] auto current() const -> std::shared_ptr<const translation_snapshot>;
+
     private:
         std::string current_locale_;
-        std::unordered_map<std::string, std::unordered_map<std::string, std::string>> translations_;
+        std::string default_locale_;
+        std::shared_ptr<lookup_statistics> statistics_;
+        atomic_shared_ptr<const translation_snapshot> state_;
+
+        /// Serialises publishing, by loads finishing on background threads and by locale changes
+        mutable std::mutex publish_mutex_;
+        std::string load_error_;
+        std::uint64_t loads_started_{ 0 };
+        std::uint64_t loads_published_{ 0 };
+        mutable std::vector<std::shared_future<bool>> background_loads_;
     };
 
 } // namespace linguist
@@ -166,3 +166,155 @@ TEST_CASE("translator returns first available translation as fallback")
     REQUIRE(translation.has_value());
     REQUIRE(*translation == "Français");
 }
+
+TEST_CASE("translator returns views into its storage")
+{
+    linguist::translator translator;
+    const auto json = read_file(test_data_file);
+    REQUIRE(translator.load_from_string(json));
+    translator.set_locale("fr-FR");
+
+    SECTION("current locale")
+    {
+        const std::string_view identifier = "home.title";
+        auto translation = translator.translate_view(identifier);
+        REQUIRE(translation.has_value());
+        REQUIRE(*translation == "Accueil");
+
+        // Repeated lookups refer to the same storage.
+        REQUIRE(translator.translate_view(identifier)->data() == translation->data());
+    }
+
+    SECTION("missing key")
+    {
+        REQUIRE(!translator.translate_view("nonexistent.key").has_value());
+        REQUIRE(translator.translate_view("nonexistent.key", "Fallback Text") == "Fallback Text");
+    }
+
+    SECTION("specific locale")
+    {
+        REQUIRE(translator.translate_view("button.save", "es-ES", true) == "Guardar");
+        REQUIRE(!translator.translate_view("button.save", "de-DE", true).has_value());
+    }
+
+    SECTION("string_view keys")
+    {
+        const std::string buffer = "home.subtitle.extra";
+        REQUIRE(translator.has_translation(std::string_view(buffer).substr(0, 13)));
+        REQUIRE(!translator.has_translation(std::string_view(buffer)));
+    }
+}
+
+TEST_CASE("translator falls back to regional variant of base language")
+{
+    const std::string json = R"({
+        "test.key": {
+            "fr-FR": "Couleur",
+            "en-US": "Color"
+        }
+    })";
+
+    linguist::translator translator;
+    REQUIRE(translator.load_from_string(json));
+    translator.set_locale("en-GB");
+
+    REQUIRE(translator.translate("test.key") == "Color");
+}
+
+TEST_CASE("translator sets and gets default locale")
+{
+    linguist::translator translator;
+    REQUIRE(translator.get_default_locale().empty());
+
+    translator.set_default_locale("en-US");
+    REQUIRE(translator.get_default_locale() == "en-US");
+}
+
+TEST_CASE("translator uses default locale before first available translation")
+{
+    const std::string json = R"({
+        "test.key": {
+            "fr-FR": "Français",
+            "es-ES": "Español"
+        },
+        "other.key": {
+            "de-DE": "Deutsch",
+            "fr-FR": "Autre"
+        }
+    })";
+
+    linguist::translator translator;
+    REQUIRE(translator.load_from_string(json));
+    translator.set_default_locale("es-ES");
+
+    SECTION("default locale is used when current locale is missing")
+    {
+        translator.set_locale("it-IT");
+        REQUIRE(translator.translate("test.key") == "Español");
+    }
+
+    SECTION("current locale takes precedence over default locale")
+    {
+        translator.set_locale("fr-FR");
+        REQUIRE(translator.translate("test.key") == "Français");
+    }
+
+    SECTION("base language takes precedence over default locale")
+    {
+        translator.set_locale("fr-CA");
+        REQUIRE(translator.translate("test.key") == "Français");
+    }
+
+    SECTION("first available translation is used when default locale is missing")
+    {
+        translator.set_locale("it-IT");
+        REQUIRE(translator.translate("other.key").has_value());
+    }
+}
+
+TEST_CASE("translator resolves locales loaded after set_locale")
+{
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+
+    const auto json = read_file(test_data_file);
+    REQUIRE(translator.load_from_string(json));
+
+    REQUIRE(translator.translate("home.title") == "Accueil");
+}
+
+TEST_CASE("translator loads translations from a stream and a file")
+{
+    linguist::translator translator;
+    translator.set_locale("es-ES");
+
+    std::istringstream stream(read_file(test_data_file));
+    REQUIRE(translator.load_from_stream(stream));
+    REQUIRE(translator.translate_view("button.save") == "Guardar");
+
+    REQUIRE(translator.load_from_string(R"({ "other.key": { "es-ES": "Otro" } })"));
+    REQUIRE(translator.load_from_file(test_data_file));
+    REQUIRE(translator.translate_view("button.save") == "Guardar");
+    REQUIRE(translator.get_load_error().empty());
+}
+
+TEST_CASE("translator keeps translations when JSON fails to load")
+{
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.load_from_string(R"({ "home.title": { "fr-FR": "Accueil" } })"));
+
+    // Malformed JSON is reported with its position
+    REQUIRE(!translator.load_from_string(R"({ "home.title": { "fr-FR": "Maison" )"));
+    REQUIRE(translator.get_load_error().find("parse error") != std::string::npos);
+    REQUIRE(translator.translate_view("home.title") == "Accueil");
+
+    // Valid JSON with an unexpected structure
+    REQUIRE(!translator.load_from_string(R"({ "home.title": { "fr-FR": 42 } })"));
+    REQUIRE(translator.get_load_error().find("home.title") != std::string::npos);
+    REQUIRE(!translator.load_from_string(R"({ "home.title": [ "Maison" ] })"));
+    REQUIRE(!translator.load_from_string(R"([])"));
+    REQUIRE(!translator.load_from_string(R"({})"));
+    REQUIRE(!translator.load_from_file(std::filesystem::path(TEST_DATA_FILE).parent_path() / "nonexistent.json"));
+    REQUIRE(translator.translate_view("home.title") == "Accueil");
+}
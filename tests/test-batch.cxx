@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/sample-keys.hxx>
+#include <linguist/translator.hxx>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("identifiers hashed together match their individual hashes")
+{
+    const std::vector<std::string_view> identifiers = { "home.title", "", "button.save", "a", "settings.account.privacy.title", "home.title.",
+        "x", "menu.file.open.recent" };
+
+    std::vector<std::uint64_t> hashes(identifiers.size());
+    linguist::hash_identifiers(identifiers, hashes);
+
+    for (std::size_t i = 0; i < identifiers.size(); ++i)
+    {
+        REQUIRE(hashes[i] == linguist::hash_identifier(identifiers[i]));
+    }
+}
+
+TEST_CASE("batch lookups match individual lookups")
+{
+    // Enough identifiers to span several prefetch blocks
+    std::string json = "{";
+    for (std::size_t i = 0; i < 50; ++i)
+    {
+        const auto number = std::to_string(i);
+        json += (i == 0 ? "\"key." : ",\"key.") + number + "\": { \"en-US\": \"Text " + number + "\"" +
+            (i % 3 == 0 ? ", \"fr-FR\": \"Texte " + number + "\"" : "") + " }";
+    }
+    json += "}";
+
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.load_from_string(json));
+
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < 60; ++i)
+    {
+        names.push_back("key." + std::to_string(i));
+    }
+
+    const std::vector<std::string_view> identifiers(names.begin(), names.end());
+    std::vector<std::optional<std::string_view>> translations(identifiers.size());
+    translator.translate_batch(identifiers, translations);
+
+    for (std::size_t i = 0; i < identifiers.size(); ++i)
+    {
+        REQUIRE(translations[i] == translator.translate_view(identifiers[i]));
+    }
+
+    REQUIRE(translations[3] == "Texte 3");
+    REQUIRE(translations[4] == "Text 4");
+    REQUIRE_FALSE(translations[55].has_value());
+}
+
+TEST_CASE("batch lookups resolve key handles")
+{
+    const auto view = linguist::catalog::embedded().view("fr-FR");
+
+    const std::array keys = { linguist::keys::home_title, linguist::keys::button_save, linguist::keys::home_subtitle };
+    std::array<std::optional<std::string_view>, keys.size()> translations;
+    view.translate_batch(keys, translations);
+    REQUIRE(translations[0] == "Accueil");
+    REQUIRE(translations[1] == "Enregistrer");
+    REQUIRE(translations[2] == "Bon retour");
+
+    // Loaded translations are searched by name
+    linguist::translator translator;
+    translator.set_locale("en-US");
+    REQUIRE(translator.load_from_string(R"({ "button.save": { "en-US": "Store" } })"));
+    translator.translate_batch(keys, translations);
+    REQUIRE_FALSE(translations[0].has_value());
+    REQUIRE(translations[1] == "Store");
+}
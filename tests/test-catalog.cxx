@@ -0,0 +1,373 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/compression.hxx>
+#include <linguist/locale-cache.hxx>
+#include <linguist/translation-catalog.hxx>
+#include <linguist/translator.hxx>
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+static auto build_sample_table(linguist::table_index index = linguist::table_index::open_addressing) -> linguist::translation_table
+{
+    linguist::translation_table::builder builder;
+    builder.add("home.title", "en-US", "Home");
+    builder.add("home.title", "fr-FR", "Accueil");
+    builder.add("button.save", "en-US", "Save");
+    return builder.build(index);
+}
+
+static void write_file(const std::filesystem::path& path, const std::string& content)
+{
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+}
+
+TEST_CASE("binary catalog round-trips a translation table")
+{
+    for (const auto index : { linguist::table_index::open_addressing, linguist::table_index::perfect_hash })
+    {
+        std::ostringstream output(std::ios::binary);
+        linguist::write_catalog(output, build_sample_table(index));
+
+        // Copy into 8-byte aligned storage, as a mapping would be
+        const auto bytes = output.str();
+        std::vector<std::uint64_t> storage((bytes.size() + 7) / 8);
+        std::memcpy(storage.data(), bytes.data(), bytes.size());
+
+        const auto data = linguist::read_catalog({ reinterpret_cast<const char*>(storage.data()), bytes.size() });
+        REQUIRE(data.has_value());
+
+        const linguist::translation_table table(*data);
+        REQUIRE(table.size() == 2);
+        REQUIRE(table.text(table.find("home.title"), *table.find_locale("fr-FR")) == "Accueil");
+        REQUIRE(table.text(table.find("button.save"), *table.find_locale("en-US")) == "Save");
+        REQUIRE(table.find("missing") == linguist::translation_table::npos);
+    }
+}
+
+TEST_CASE("binary catalog rejects invalid data")
+{
+    std::ostringstream output(std::ios::binary);
+    linguist::write_catalog(output, build_sample_table());
+    const auto bytes = output.str();
+
+    std::vector<std::uint64_t> storage((bytes.size() + 7) / 8);
+    auto* catalog = reinterpret_cast<char*>(storage.data());
+    std::memcpy(catalog, bytes.data(), bytes.size());
+
+    // Truncated
+    REQUIRE(!linguist::read_catalog({ catalog, sizeof(linguist::catalog_header) - 1 }).has_value());
+    REQUIRE(!linguist::read_catalog({ catalog, bytes.size() - 1 }).has_value());
+
+    // Unsupported version
+    linguist::catalog_header header;
+    std::memcpy(&header, catalog, sizeof(header));
+    header.version = linguist::catalog_version + 1;
+    std::memcpy(catalog, &header, sizeof(header));
+    REQUIRE(!linguist::read_catalog({ catalog, bytes.size() }).has_value());
+
+    // Wrong magic
+    header.version = linguist::catalog_version;
+    header.magic[0] = '{';
+    std::memcpy(catalog, &header, sizeof(header));
+    REQUIRE(!linguist::read_catalog({ catalog, bytes.size() }).has_value());
+}
+
+TEST_CASE("binary catalog rejects corrupt offsets")
+{
+    linguist::translation_table::builder builder;
+    builder.add("home.title", "en-US", "Home");
+    builder.add("files", "en-US", "{count, plural, one {# file} other {# files}}");
+    std::ostringstream output(std::ios::binary);
+    linguist::write_catalog(output, builder.build());
+    const auto bytes = output.str();
+
+    linguist::catalog_header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    // Overwrite one 32-bit value of a section, and read the corrupted catalog
+    const auto read_corrupted = [&](const linguist::catalog_section& section, std::size_t position, std::uint32_t value)
+    {
+        std::vector<std::uint64_t> storage((bytes.size() + 7) / 8);
+        auto* catalog = reinterpret_cast<char*>(storage.data());
+        std::memcpy(catalog, bytes.data(), bytes.size());
+        std::memcpy(catalog + section.offset + position * sizeof(value), &value, sizeof(value));
+        return linguist::read_catalog({ catalog, bytes.size() });
+    };
+
+    const auto arena_size = static_cast<std::uint32_t>(header.arena.size);
+    REQUIRE(read_corrupted(header.keys, 0, 0).has_value());
+    REQUIRE_FALSE(read_corrupted(header.keys, 0, arena_size).has_value());
+    REQUIRE_FALSE(read_corrupted(header.keys, 1, arena_size - 2).has_value());
+    REQUIRE_FALSE(read_corrupted(header.locales, 0, 0xFFFFFFFF).has_value());
+    REQUIRE_FALSE(read_corrupted(header.matrix, 0, arena_size + 100).has_value());
+
+    // Index slots are (tag, row) pairs; rows must exist, and probing must reach an empty slot
+    REQUIRE_FALSE(read_corrupted(header.index, 1, 2).has_value());
+    std::vector<std::uint64_t> storage((bytes.size() + 7) / 8);
+    auto* catalog = reinterpret_cast<char*>(storage.data());
+    std::memcpy(catalog, bytes.data(), bytes.size());
+    for (std::size_t slot = 0; slot < header.index.size / sizeof(linguist::table_slot); ++slot)
+    {
+        const std::uint32_t row = 0;
+        std::memcpy(catalog + header.index.offset + slot * sizeof(linguist::table_slot) + sizeof(row), &row, sizeof(row));
+    }
+    REQUIRE_FALSE(linguist::read_catalog({ catalog, bytes.size() }).has_value());
+
+    // Message operations must stay within their pattern and message
+    REQUIRE(header.message_ops.size > 0);
+    REQUIRE_FALSE(read_corrupted(header.message_ops, 1, 1000).has_value());
+    REQUIRE_FALSE(read_corrupted(header.messages, 0, arena_size).has_value());
+
+    // Operations are (code, offset, size, value, end); the plural must keep its "other" case, and cases their plural
+    const auto field = sizeof(linguist::message_op) / sizeof(std::uint32_t);
+    REQUIRE(read_corrupted(header.message_ops, 4 * field + 3, static_cast<std::uint32_t>(linguist::plural_category::other)).has_value());
+    REQUIRE_FALSE(read_corrupted(header.message_ops, 4 * field + 3, static_cast<std::uint32_t>(linguist::plural_category::many)).has_value());
+    REQUIRE_FALSE(read_corrupted(header.message_ops, 0, static_cast<std::uint32_t>(linguist::message_opcode::plural_case)).has_value());
+
+    // Counts cannot exceed the identifiers
+    REQUIRE(read_corrupted(header.counts, 0, 2).has_value());
+    REQUIRE_FALSE(read_corrupted(header.counts, 0, 3).has_value());
+}
+
+TEST_CASE("binary catalog counts a locale without viewing its table")
+{
+    std::ostringstream output(std::ios::binary);
+    linguist::write_catalog(output, build_sample_table());
+    const auto bytes = output.str();
+
+    std::vector<std::uint64_t> storage((bytes.size() + 7) / 8);
+    auto* catalog = reinterpret_cast<char*>(storage.data());
+    std::memcpy(catalog, bytes.data(), bytes.size());
+
+    REQUIRE(linguist::catalog_translated_count({ catalog, bytes.size() }, "en-US") == 2);
+    REQUIRE(linguist::catalog_translated_count({ catalog, bytes.size() }, "fr-FR") == 1);
+    REQUIRE(linguist::catalog_translated_count({ catalog, bytes.size() }, "de-DE") == 0);
+    REQUIRE(linguist::read_catalog({ catalog, bytes.size() })->counts.size() == 2);
+
+    // Compressed catalogs must be decompressed to count them
+    std::ostringstream compressed(std::ios::binary);
+    linguist::write_catalog(compressed, build_sample_table(), linguist::catalog_compression::lz);
+    REQUIRE_FALSE(linguist::catalog_translated_count(compressed.str(), "en-US").has_value());
+}
+
+TEST_CASE("compression round-trips repetitive and random bytes")
+{
+    std::string repetitive;
+    for (int32_t i = 0; i < 2000; ++i)
+    {
+        repetitive += "settings.item_" + std::to_string(i % 50) + " Paramètres ";
+    }
+
+    std::mt19937 engine(7);
+    std::string random(5000, '\0');
+    for (auto& character : random)
+    {
+        character = static_cast<char>(engine());
+    }
+
+    for (const auto& input : { std::string(), std::string("a"), std::string(300, 'x'), repetitive, random })
+    {
+        const auto compressed = linguist::compress(input);
+        std::string output(input.size(), '\0');
+        REQUIRE(linguist::decompress(compressed, output));
+        REQUIRE(output == input);
+
+        // Output of the wrong size is rejected
+        std::string larger(input.size() + 1, '\0');
+        REQUIRE_FALSE(linguist::decompress(compressed, larger));
+    }
+
+    // Repeated text is stored once
+    REQUIRE(linguist::compress(repetitive).size() < repetitive.size() / 10);
+}
+
+TEST_CASE("locale cache counts embedded sections without materialising them")
+{
+    const auto table = build_sample_table();
+    const linguist::locale_cache cache({ { "en-US", {}, table.data(), {} }, { "fr-FR", {}, table.data(), {} }, { "de-DE", {}, table.data(), {} } }, 0);
+    REQUIRE(cache.translated_count(0) == 2);
+    REQUIRE(cache.translated_count(1) == 1);
+    REQUIRE(cache.translated_count(2) == 0);
+    REQUIRE(cache.memory_usage() == 0);
+    REQUIRE(cache.loaded_locales().empty());
+}
+
+TEST_CASE("compressed catalog round-trips a translation table")
+{
+    std::ostringstream output(std::ios::binary);
+    linguist::write_catalog(output, build_sample_table(), linguist::catalog_compression::lz);
+    const auto bytes = output.str();
+
+    const auto size = linguist::compressed_catalog_size(bytes);
+    REQUIRE(size.has_value());
+
+    const auto table = linguist::view_compressed_catalog(bytes);
+    REQUIRE(table != nullptr);
+    REQUIRE(table->size() == 2);
+    REQUIRE(table->text(table->find("home.title"), *table->find_locale("fr-FR")) == "Accueil");
+
+    // Embedded compressed locales are decompressed when first acquired
+    const linguist::locale_cache cache({ { "fr-FR", {}, {}, bytes } }, 0);
+    REQUIRE(cache.memory_usage() == 0);
+    REQUIRE_FALSE(cache.translated_count(0).has_value());
+    REQUIRE(cache.registry()[0].translated == linguist::locale_info::unknown);
+    REQUIRE(cache.acquire(0)->text(0, 0) == table->text(0, 0));
+    REQUIRE(cache.memory_usage() == *size);
+
+    // Loading the locale counts it
+    REQUIRE(cache.translated_count(0) == 1);
+    REQUIRE(cache.registry()[0].translated == 1);
+
+    // Truncated or uncompressed catalogs are rejected
+    REQUIRE(linguist::view_compressed_catalog(std::string_view(bytes).substr(0, bytes.size() - 1)) == nullptr);
+    REQUIRE(linguist::view_compressed_catalog(std::string_view(bytes).substr(0, sizeof(linguist::compressed_catalog_header) - 1)) == nullptr);
+
+    std::ostringstream uncompressed(std::ios::binary);
+    linguist::write_catalog(uncompressed, build_sample_table());
+    REQUIRE_FALSE(linguist::compressed_catalog_size(uncompressed.str()).has_value());
+}
+
+TEST_CASE("compressed catalog rejects a tampered size")
+{
+    std::ostringstream output(std::ios::binary);
+    linguist::write_catalog(output, build_sample_table(), linguist::catalog_compression::lz);
+    auto bytes = output.str();
+
+    // Claim a decompressed size far beyond what the compressed bytes could expand to
+    linguist::compressed_catalog_header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.size = std::uint64_t{ 1 } << 50;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    REQUIRE_FALSE(linguist::compressed_catalog_size(bytes).has_value());
+    REQUIRE(linguist::view_compressed_catalog(bytes) == nullptr);
+
+    // The largest size the bytes could hold is allocated, but fails to decompress
+    header.size = (bytes.size() - sizeof(header)) * linguist::max_expansion;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    REQUIRE(linguist::compressed_catalog_size(bytes) == header.size);
+    REQUIRE(linguist::view_compressed_catalog(bytes) == nullptr);
+
+    header.size = std::uint64_t{ 1 } << 50;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    // Loading the catalog fails, and a tampered locale of a directory fails alone
+    const std::filesystem::path k_test_catalog = std::filesystem::temp_directory_path() / "test_tampered.lcat";
+    const std::filesystem::path k_test_directory = std::filesystem::temp_directory_path() / "test_tampered_catalogs";
+    std::filesystem::remove_all(k_test_directory);
+    std::filesystem::create_directories(k_test_directory);
+    {
+        std::ofstream out(k_test_catalog, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        std::ofstream tampered(k_test_directory / "fr-FR.lcat", std::ios::binary);
+        tampered.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        std::ofstream valid(k_test_directory / "de-DE.json");
+        valid << R"({ "home.title": { "de-DE": "Startseite" } })";
+    }
+
+    linguist::translator translator;
+    REQUIRE_FALSE(translator.load_mapped(k_test_catalog));
+    REQUIRE_FALSE(translator.get_load_error().empty());
+
+    REQUIRE(translator.load_directory(k_test_directory));
+    REQUIRE_FALSE(translator.translate_view("home.title", "fr-FR", true).has_value());
+    REQUIRE(translator.translate_view("home.title", "de-DE", true) == "Startseite");
+
+    std::filesystem::remove(k_test_catalog);
+    std::filesystem::remove_all(k_test_directory);
+}
+
+TEST_CASE("translator loads a memory-mapped catalog")
+{
+    const std::filesystem::path k_test_catalog = std::filesystem::temp_directory_path() / "test_mapped.lcat";
+    {
+        std::ofstream out(k_test_catalog, std::ios::binary);
+        linguist::write_catalog(out, build_sample_table());
+    }
+
+    linguist::translator translator;
+    REQUIRE(translator.load_mapped(k_test_catalog));
+
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.translate_view("home.title") == "Accueil");
+    REQUIRE(translator.translate("button.save") == "Save");
+    REQUIRE(!translator.translate_view("welcome.message").has_value());
+
+    // Loading JSON afterwards releases the mapping
+    REQUIRE(translator.load_from_string(R"({ "other.key": { "fr-FR": "Autre" } })"));
+    REQUIRE(translator.translate_view("other.key") == "Autre");
+
+    std::filesystem::remove(k_test_catalog);
+}
+
+TEST_CASE("translator keeps translations when a catalog fails to load")
+{
+    const std::filesystem::path k_test_catalog = std::filesystem::temp_directory_path() / "test_invalid.lcat";
+    write_file(k_test_catalog, "{ \"home.title\": { \"en-US\": \"Home\" } }");
+
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+
+    REQUIRE(!translator.load_mapped(k_test_catalog));
+    REQUIRE(!translator.load_mapped(std::filesystem::temp_directory_path() / "nonexistent.lcat"));
+    REQUIRE(translator.translate_view("home.title") == "Accueil");
+
+    std::filesystem::remove(k_test_catalog);
+}
+
+TEST_CASE("Embedding tool generates a binary catalog")
+{
+    const std::filesystem::path k_test_catalog = std::filesystem::temp_directory_path() / "test_tool.lcat";
+
+    // Run the embedding tool
+    std::string command = std::string(EMBED_TOOL_PATH) + " --binary --perfect-hash " + std::string(TEST_DATA_FILE) + " " + k_test_catalog.string();
+    int32_t result = std::system(command.c_str());
+    REQUIRE(result == 0);
+
+    linguist::translator translator;
+    REQUIRE(translator.load_mapped(k_test_catalog));
+
+    translator.set_locale("es-ES");
+    REQUIRE(translator.translate_view("button.save") == "Guardar");
+
+    std::filesystem::remove(k_test_catalog);
+}
+
+TEST_CASE("Embedding tool generates compressed catalogs")
+{
+    const std::filesystem::path k_test_catalog = std::filesystem::temp_directory_path() / "test_compressed.lcat";
+    const std::filesystem::path k_test_directory = std::filesystem::temp_directory_path() / "test_compressed_catalogs";
+    std::filesystem::remove_all(k_test_directory);
+
+    // Run the embedding tool
+    std::string command = std::string(EMBED_TOOL_PATH) + " --binary --compress " + std::string(TEST_DATA_FILE) + " " + k_test_catalog.string();
+    REQUIRE(std::system(command.c_str()) == 0);
+
+    command = std::string(EMBED_TOOL_PATH) + " --binary --split-locales --compress " + std::string(TEST_DATA_FILE) + " " + k_test_directory.string();
+    REQUIRE(std::system(command.c_str()) == 0);
+
+    linguist::translator translator;
+    translator.set_locale("es-ES");
+    REQUIRE(translator.load_mapped(k_test_catalog));
+    REQUIRE(translator.translate_view("button.save") == "Guardar");
+
+    // Per-locale catalogs are decompressed on demand
+    REQUIRE(translator.load_directory(k_test_directory, 1));
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "es-ES" });
+    REQUIRE(translator.translate_view("button.save") == "Guardar");
+    REQUIRE(translator.translate("button.save", "fr-FR", true) == "Enregistrer");
+
+    std::filesystem::remove(k_test_catalog);
+    std::filesystem::remove_all(k_test_directory);
+}
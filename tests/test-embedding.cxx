@@ -2,10 +2,18 @@
 // Copyright (c) 2025 Jamie Kenyon. All Rights Reserved.
 //
 
+#include <linguist/sample-keys.hxx>
+#include <linguist/translation-catalog.hxx>
 #include <linguist/translator.hxx>
 
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
 #include <catch2/catch_test_macros.hpp>
 
 TEST_CASE("Embedding tool generates valid C++ code")
@@ -44,6 +52,7 @@ TEST_CASE("Embedding tool generates valid C++ code")
         // Verify content contains expected structure
         REQUIRE(content.find("namespace linguist") != std::string::npos);
         REQUIRE(content.find("get_embedded_translations") != std::string::npos);
+        REQUIRE(content.find("table_data") != std::string::npos);
         REQUIRE(content.find("test.key1") != std::string::npos);
         REQUIRE(content.find("test.key2") != std::string::npos);
         REQUIRE(content.find("Value 1") != std::string::npos);
@@ -55,6 +64,328 @@ TEST_CASE("Embedding tool generates valid C++ code")
     std::filesystem::remove(k_test_output);
 }
 
+TEST_CASE("Embedding tool generates a perfect hash index")
+{
+    const std::filesystem::path k_test_json = std::filesystem::temp_directory_path() / "test_perfect_hash.json";
+    const std::filesystem::path k_test_output = std::filesystem::temp_directory_path() / "test_perfect_hash.cxx";
+
+    // Create a test JSON file
+    {
+        std::ofstream out(k_test_json);
+        out << R"({
+    "test.key1": {
+        "en-US": "Value 1"
+    },
+    "test.key2": {
+        "en-US": "Value 2"
+    }
+})";
+    }
+
+    // Run the embedding tool
+    std::string command = std::string(EMBED_TOOL_PATH) + " --perfect-hash " + k_test_json.string() + " " + k_test_output.string();
+    int32_t result = std::system(command.c_str());
+    REQUIRE(result == 0);
+
+    // Read the generated file
+    {
+        std::ifstream in(k_test_output);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        // Verify the displacement table is emitted and referenced
+        REQUIRE(content.find("displacements[]") != std::string::npos);
+        REQUIRE(content.find("matrix, displacements, {}, {}, counts }") != std::string::npos);
+    }
+
+    // Cleanup
+    std::filesystem::remove(k_test_json);
+    std::filesystem::remove(k_test_output);
+}
+
+TEST_CASE("Embedding tool generates key handles")
+{
+    const std::filesystem::path k_test_json = std::filesystem::temp_directory_path() / "test_keys.json";
+    const std::filesystem::path k_test_output = std::filesystem::temp_directory_path() / "test_keys.cxx";
+    const std::filesystem::path k_test_keys = std::filesystem::temp_directory_path() / "test_keys.hxx";
+
+    // Create a test JSON file
+    {
+        std::ofstream out(k_test_json);
+        out << R"({
+    "menu.file-open": {
+        "en-US": "Open"
+    },
+    "2fa.prompt": {
+        "en-US": "Code"
+    },
+    "delete": {
+        "en-US": "Delete"
+    }
+})";
+    }
+
+    // Run the embedding tool
+    std::string command = std::string(EMBED_TOOL_PATH) + " --keys " + k_test_keys.string() + " " + k_test_json.string() + " " + k_test_output.string();
+    int32_t result = std::system(command.c_str());
+    REQUIRE(result == 0);
+
+    // Read the generated header
+    {
+        std::ifstream in(k_test_keys);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        // Verify identifiers are converted into valid C++ names
+        REQUIRE(content.find("namespace linguist::keys") != std::string::npos);
+        REQUIRE(content.find("inline constexpr key_id menu_file_open{ 0u, \"menu.file-open\" };") != std::string::npos);
+        REQUIRE(content.find("inline constexpr key_id _2fa_prompt{ 1u, \"2fa.prompt\" };") != std::string::npos);
+        REQUIRE(content.find("inline constexpr key_id _delete{ 2u, \"delete\" };") != std::string::npos);
+    }
+
+    // Cleanup
+    std::filesystem::remove(k_test_json);
+    std::filesystem::remove(k_test_output);
+    std::filesystem::remove(k_test_keys);
+}
+
+TEST_CASE("Embedding tool fails on conflicting key handles")
+{
+    const std::filesystem::path k_test_json = std::filesystem::temp_directory_path() / "test_conflict.json";
+    const std::filesystem::path k_test_output = std::filesystem::temp_directory_path() / "test_conflict.cxx";
+    const std::filesystem::path k_test_keys = std::filesystem::temp_directory_path() / "test_conflict.hxx";
+
+    // Create a JSON file whose identifiers map to the same name
+    {
+        std::ofstream out(k_test_json);
+        out << R"({
+    "home.title": {
+        "en-US": "Home"
+    },
+    "home_title": {
+        "en-US": "Home"
+    }
+})";
+    }
+
+    // Run the embedding tool - should fail
+    std::string command = std::string(EMBED_TOOL_PATH) + " --keys " + k_test_keys.string() + " " + k_test_json.string() + " " + k_test_output.string();
+    int32_t result = std::system(command.c_str());
+    REQUIRE(result != 0);
+
+    // Cleanup
+    std::filesystem::remove(k_test_json);
+    std::filesystem::remove(k_test_output);
+    std::filesystem::remove(k_test_keys);
+}
+
+TEST_CASE("Embedding tool merges several input files")
+{
+    const std::filesystem::path k_test_english = std::filesystem::temp_directory_path() / "test_merge_en.json";
+    const std::filesystem::path k_test_french = std::filesystem::temp_directory_path() / "test_merge_fr.json";
+    const std::filesystem::path k_test_output = std::filesystem::temp_directory_path() / "test_merge.cxx";
+    const std::filesystem::path k_test_keys = std::filesystem::temp_directory_path() / "test_merge.hxx";
+
+    // Create one JSON file per locale
+    {
+        std::ofstream out(k_test_english);
+        out << R"({
+    "merge.first": { "en-US": "First" },
+    "merge.second": { "en-US": "Second" }
+})";
+    }
+    {
+        std::ofstream out(k_test_french);
+        out << R"({
+    "merge.second": { "fr-FR": "Deuxieme" },
+    "merge.third": { "fr-FR": "Troisieme" }
+})";
+    }
+
+    // Run the embedding tool
+    std::string command = std::string(EMBED_TOOL_PATH) + " --keys " + k_test_keys.string() + " " + k_test_english.string() + " " +
+                          k_test_french.string() + " " + k_test_output.string();
+    int32_t result = std::system(command.c_str());
+    REQUIRE(result == 0);
+
+    // Read the generated files
+    {
+        std::ifstream in(k_test_output);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        REQUIRE(content.find("Second") != std::string::npos);
+        REQUIRE(content.find("Deuxieme") != std::string::npos);
+        REQUIRE(content.find("Troisieme") != std::string::npos);
+    }
+    {
+        std::ifstream in(k_test_keys);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        // Verify identifiers keep the order of the files
+        REQUIRE(content.find("inline constexpr key_id merge_second{ 1u, \"merge.second\" };") != std::string::npos);
+        REQUIRE(content.find("inline constexpr key_id merge_third{ 2u, \"merge.third\" };") != std::string::npos);
+    }
+
+    // Cleanup
+    std::filesystem::remove(k_test_english);
+    std::filesystem::remove(k_test_french);
+    std::filesystem::remove(k_test_output);
+    std::filesystem::remove(k_test_keys);
+}
+
+TEST_CASE("Embedding tool fails on translations defined by several input files")
+{
+    const std::filesystem::path k_test_first = std::filesystem::temp_directory_path() / "test_overlap_1.json";
+    const std::filesystem::path k_test_second = std::filesystem::temp_directory_path() / "test_overlap_2.json";
+    const std::filesystem::path k_test_output = std::filesystem::temp_directory_path() / "test_overlap.cxx";
+
+    // Create two JSON files translating the same identifier and locale
+    {
+        std::ofstream out(k_test_first);
+        out << R"({ "shared": { "en-US": "One", "fr-FR": "Un" } })";
+    }
+    {
+        std::ofstream out(k_test_second);
+        out << R"({ "shared": { "de-DE": "Zwei", "en-US": "Two" } })";
+    }
+
+    // Run the embedding tool - should fail
+    std::string command = std::string(EMBED_TOOL_PATH) + " " + k_test_first.string() + " " + k_test_second.string() + " " + k_test_output.string();
+    int32_t result = std::system(command.c_str());
+    REQUIRE(result != 0);
+    REQUIRE(!std::filesystem::exists(k_test_output));
+
+    // Cleanup
+    std::filesystem::remove(k_test_first);
+    std::filesystem::remove(k_test_second);
+}
+
+TEST_CASE("Embedding tool includes a binary catalog")
+{
+    const std::filesystem::path k_test_json = std::filesystem::temp_directory_path() / "test_blob.json";
+    const std::filesystem::path k_test_output = std::filesystem::temp_directory_path() / "test_blob.cxx";
+    const std::filesystem::path k_test_catalog = std::filesystem::temp_directory_path() / "test_blob.lcat";
+
+    // Create a test JSON file
+    {
+        std::ofstream out(k_test_json);
+        out << R"({
+    "test.key1": {
+        "en-US": "Value 1",
+        "fr-FR": "Valeur 1"
+    }
+})";
+    }
+
+    // Run the embedding tool
+    std::string command = std::string(EMBED_TOOL_PATH) + " --blob " + k_test_json.string() + " " + k_test_output.string();
+    int32_t result = std::system(command.c_str());
+    REQUIRE(result == 0);
+
+    // Verify the source includes the catalog instead of spelling it out
+    {
+        std::ifstream in(k_test_output);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        REQUIRE(content.find("#embed \"" + std::filesystem::absolute(k_test_catalog).generic_string() + "\"") != std::string::npos);
+        REQUIRE(content.find(".incbin") != std::string::npos);
+        REQUIRE(content.find("get_embedded_translations") != std::string::npos);
+        REQUIRE(content.find("Valeur 1") == std::string::npos);
+    }
+
+    // Verify the catalog holds the translations
+    {
+        std::ifstream in(k_test_catalog, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::vector<std::uint64_t> storage((bytes.size() + 7) / 8);
+        std::memcpy(storage.data(), bytes.data(), bytes.size());
+
+        const auto data = linguist::read_catalog({ reinterpret_cast<const char*>(storage.data()), bytes.size() });
+        REQUIRE(data.has_value());
+
+        const linguist::translation_table table(*data);
+        REQUIRE(table.text(table.find("test.key1"), *table.find_locale("fr-FR")) == "Valeur 1");
+    }
+
+    // Split locales share the one blob, so that the build system can name it
+    command = std::string(EMBED_TOOL_PATH) + " --blob --split-locales " + k_test_json.string() + " " + k_test_output.string();
+    REQUIRE(std::system(command.c_str()) == 0);
+    REQUIRE_FALSE(std::filesystem::exists(std::filesystem::temp_directory_path() / "test_blob.fr-FR.lcat"));
+    {
+        std::ifstream in(k_test_output);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        REQUIRE(content.find("#embed \"" + std::filesystem::absolute(k_test_catalog).generic_string() + "\"") != std::string::npos);
+        REQUIRE(content.find("{ \"en-US\", view(LINGUIST_CATALOG(embedded_catalogs).subspan(0, ") != std::string::npos);
+        REQUIRE(content.find("{ \"fr-FR\", view(LINGUIST_CATALOG(embedded_catalogs).subspan(") != std::string::npos);
+    }
+
+    // Cleanup
+    std::filesystem::remove(k_test_json);
+    std::filesystem::remove(k_test_output);
+    std::filesystem::remove(k_test_catalog);
+}
+
+TEST_CASE("Embedding tool only rewrites changed shards")
+{
+    const std::filesystem::path k_test_json = std::filesystem::temp_directory_path() / "test_shards.json";
+    const std::filesystem::path k_test_output = std::filesystem::temp_directory_path() / "test_shards.cxx";
+    const std::array k_test_shards = { std::filesystem::temp_directory_path() / "test_shards_0.cxx",
+        std::filesystem::temp_directory_path() / "test_shards_1.cxx", std::filesystem::temp_directory_path() / "test_shards_2.cxx" };
+
+    const auto read = [](const std::filesystem::path& path)
+    {
+        std::ifstream in(path);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    };
+
+    // Create a test JSON file with several locales
+    const auto write_json = [&](std::string_view german)
+    {
+        std::ofstream out(k_test_json);
+        out << R"({ "test.key1": { "en-US": "Value 1", "fr-FR": "Valeur 1", "es-ES": "Valor 1", "de-DE": ")" << german << R"(" } })";
+    };
+    write_json("Wert 1");
+
+    // Run the embedding tool
+    std::string command = std::string(EMBED_TOOL_PATH) + " --shards 3 " + k_test_json.string() + " " + k_test_output.string();
+    REQUIRE(std::system(command.c_str()) == 0);
+    REQUIRE(read(k_test_output).find("get_embedded_shard_2()") != std::string::npos);
+
+    std::array<std::string, 3> contents;
+    std::array<std::filesystem::file_time_type, 3> times;
+    for (std::size_t shard = 0; shard < k_test_shards.size(); ++shard)
+    {
+        contents[shard] = read(k_test_shards[shard]);
+        times[shard] = std::filesystem::last_write_time(k_test_shards[shard]);
+    }
+
+    // Change one locale, then verify only the shard holding it was rewritten
+    write_json("Neuer Wert");
+    REQUIRE(std::system(command.c_str()) == 0);
+
+    std::size_t changed = 0;
+    for (std::size_t shard = 0; shard < k_test_shards.size(); ++shard)
+    {
+        const auto content = read(k_test_shards[shard]);
+        if (content == contents[shard])
+        {
+            REQUIRE(std::filesystem::last_write_time(k_test_shards[shard]) == times[shard]);
+        }
+        else
+        {
+            REQUIRE(content.find("Neuer Wert") != std::string::npos);
+            ++changed;
+        }
+    }
+    REQUIRE(changed == 1);
+
+    // Cleanup
+    std::filesystem::remove(k_test_json);
+    std::filesystem::remove(k_test_output);
+    for (const auto& shard : k_test_shards)
+    {
+        std::filesystem::remove(shard);
+    }
+}
+
 TEST_CASE("Embedding tool handles quotes correctly")
 {
     const std::filesystem::path k_test_json = std::filesystem::temp_directory_path() / "test_quotes.json";
@@ -126,3 +457,37 @@ TEST_CASE("Embedding tool fails on missing input file")
     // Output file should not be created
     REQUIRE(!std::filesystem::exists(k_test_output));
 }
+
+TEST_CASE("translator references embedded translations in place")
+{
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+
+    auto translation = translator.translate_view("home.title");
+    REQUIRE(translation.has_value());
+    REQUIRE(*translation == "Accueil");
+
+    // The view points into the constant data generated by the embed tool.
+    const auto arena = linguist::get_embedded_translations().arena;
+    REQUIRE(translation->data() >= arena.data());
+    REQUIRE(translation->data() + translation->size() < arena.data() + arena.size());
+}
+
+TEST_CASE("translator translates compile-time key handles")
+{
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+
+    REQUIRE(translator.translate_view(linguist::keys::home_title) == "Accueil");
+    REQUIRE(translator.translate(linguist::keys::button_save) == "Enregistrer");
+    REQUIRE(translator.translate_view(linguist::keys::home_title) == translator.translate_view("home.title"));
+
+    // After loading other translations, handles are looked up by name
+    REQUIRE(translator.load_from_string(R"({
+        "other.key": { "fr-FR": "Autre" },
+        "home.title": { "fr-FR": "Page d'accueil" }
+    })"));
+    REQUIRE(translator.translate_view(linguist::keys::home_title) == "Page d'accueil");
+    REQUIRE(translator.translate(linguist::keys::button_save, "Save") == "Save");
+    REQUIRE(translator.translate_view(linguist::keys::home_subtitle, "Fallback") == "Fallback");
+}
@@ -0,0 +1,281 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/translator.hxx>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+static void write_file(const std::filesystem::path& path, const std::string& content)
+{
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+}
+
+/// Write one JSON catalog per locale into a fresh directory
+static auto make_locale_directory(const std::string& name) -> std::filesystem::path
+{
+    const auto directory = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    write_file(directory / "en-US.json", R"({ "home.title": { "en-US": "Home" }, "only.english": { "en-US": "English" } })");
+    write_file(directory / "fr-FR.json", R"({ "home.title": { "fr-FR": "Accueil" } })");
+    write_file(directory / "es-ES.json", R"({ "home.title": { "es-ES": "Inicio" } })");
+    return directory;
+}
+
+TEST_CASE("translator loads split catalogs on demand")
+{
+    const auto directory = std::filesystem::temp_directory_path() / "test_split_catalogs";
+    std::filesystem::remove_all(directory);
+
+    // Split the sample translations into one binary catalog per locale
+    std::string command = std::string(EMBED_TOOL_PATH) + " --binary --split-locales " + TEST_DATA_FILE + " " + directory.string();
+    REQUIRE(std::system(command.c_str()) == 0);
+    REQUIRE(std::filesystem::exists(directory / "en-US.lcat"));
+    REQUIRE(std::filesystem::exists(directory / "fr-FR.lcat"));
+    REQUIRE(std::filesystem::exists(directory / "es-ES.lcat"));
+
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.load_directory(directory));
+    REQUIRE(translator.get_available_locales() == std::vector<std::string>{ "en-US", "es-ES", "fr-FR" });
+
+    // Binary catalogs store their counts, so they are known without loading the locales
+    linguist::translator whole;
+    REQUIRE(whole.load_from_file(TEST_DATA_FILE));
+    const auto locales = translator.available_locales();
+    REQUIRE(locales.size() == whole.available_locales().size());
+    for (std::size_t i = 0; i < locales.size(); ++i)
+    {
+        REQUIRE(locales[i].translated == whole.available_locales()[i].translated);
+    }
+
+    // Only the locales of the fallback chain are loaded
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "fr-FR" });
+    REQUIRE(translator.translate_view("home.title") == "Accueil");
+    REQUIRE(translator.translate("button.save") == "Enregistrer");
+
+    // Lookups for a specific locale load it on first use
+    REQUIRE(translator.translate("home.title", "es-ES", true) == "Inicio");
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "es-ES", "fr-FR" });
+    REQUIRE_FALSE(translator.translate("home.title", "de-DE", true).has_value());
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("split catalogs only fall back through the locale chain")
+{
+    const auto directory = make_locale_directory("test_split_fallback");
+
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.load_directory(directory));
+
+    // Locales outside the chain are never loaded to find a last resort
+    REQUIRE(translator.translate_view("home.title") == "Accueil");
+    REQUIRE_FALSE(translator.translate_view("only.english").has_value());
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "fr-FR" });
+
+    translator.set_default_locale("en-US");
+    REQUIRE(translator.translate_view("only.english") == "English");
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "en-US", "fr-FR" });
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("split JSON catalogs are counted once loaded")
+{
+    const auto directory = make_locale_directory("test_split_counts");
+
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.load_directory(directory));
+
+    // Counting a JSON catalog would parse it, so only the loaded locale is counted
+    const auto before = translator.available_locales();
+    REQUIRE(before.size() == 3);
+    REQUIRE(before[0].translated == linguist::locale_info::unknown);
+    REQUIRE(before[1].translated == linguist::locale_info::unknown);
+    REQUIRE(before[2].translated == 1);
+
+    REQUIRE(translator.translate("only.english", "en-US", true) == "English");
+    const auto after = translator.available_locales();
+    REQUIRE(after[0].locale == "en-US");
+    REQUIRE(after[0].translated == 2);
+    REQUIRE(after[1].translated == linguist::locale_info::unknown);
+
+    // Registries returned earlier stay valid
+    REQUIRE(before[0].locale == "en-US");
+    REQUIRE(before[0].translated == linguist::locale_info::unknown);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("split catalogs evict least recently used locales")
+{
+    const auto directory = make_locale_directory("test_split_eviction");
+
+    // A limit of one byte keeps nothing but the locales in use
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.load_directory(directory, 1));
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "fr-FR" });
+
+    REQUIRE(translator.translate("home.title", "es-ES", true) == "Inicio");
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "es-ES", "fr-FR" });
+
+    translator.set_locale("en-US");
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "en-US" });
+    REQUIRE(translator.translate_view("home.title") == "Home");
+
+    // Evicted locales are loaded again when needed
+    REQUIRE(translator.translate("home.title", "fr-FR", true) == "Accueil");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("split catalogs evict locales looked up per call under the memory limit")
+{
+    const auto directory = make_locale_directory("test_split_per_call");
+
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.load_directory(directory, 1));
+
+    // Copied translations do not keep their locale loaded, so loading another evicts it
+    REQUIRE(translator.translate("home.title", "es-ES", true) == "Inicio");
+    REQUIRE(translator.translate("home.title", "en-US", true) == "Home");
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "en-US", "fr-FR" });
+
+    // Views keep their locales loaded while the snapshot is held, however many other locales load
+    {
+        const auto snapshot = translator.snapshot();
+        const auto spanish = snapshot->translate_view("home.title", "es-ES", true);
+        REQUIRE(spanish == "Inicio");
+        REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "es-ES", "fr-FR" });
+        REQUIRE(snapshot->translate_view("home.title", "en-US", true) == "Home");
+        REQUIRE(translator.translate("home.title", "es-ES", true) == "Inicio");
+        REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "en-US", "es-ES", "fr-FR" });
+        REQUIRE(spanish == "Inicio");
+    }
+
+    // The translator's snapshot keeps them until the locale changes
+    REQUIRE(translator.translate_view("home.title", "es-ES", true) == "Inicio");
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "fr-FR" });
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("split catalogs load each locale once across threads")
+{
+    const auto directory = make_locale_directory("test_split_threads");
+    write_file(directory / "de-DE.json", R"({ "home.title": )");
+
+    linguist::translator translator;
+    translator.set_locale("en-US");
+    REQUIRE(translator.load_directory(directory));
+
+    // Threads needing different locales load them side by side, and share them once loaded
+    std::vector<std::thread> threads;
+    std::vector<std::string> results(8);
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        threads.emplace_back(
+            [&, i]()
+            {
+                const auto* locale = i % 2 == 0 ? "fr-FR" : "es-ES";
+                for (int lookup = 0; lookup < 100; ++lookup)
+                {
+                    results[i] = translator.translate("home.title", locale, true).value_or("");
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        REQUIRE(results[i] == (i % 2 == 0 ? "Accueil" : "Inicio"));
+    }
+
+    // A catalog that fails to load is not read again on every lookup
+    REQUIRE_FALSE(translator.translate("home.title", "de-DE", true).has_value());
+    write_file(directory / "de-DE.json", R"({ "home.title": { "de-DE": "Startseite" } })");
+    REQUIRE_FALSE(translator.translate("home.title", "de-DE", true).has_value());
+    REQUIRE(translator.get_loaded_locales() == std::vector<std::string>{ "en-US", "es-ES", "fr-FR" });
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("translator keeps translations when no split catalogs are found")
+{
+    const auto directory = std::filesystem::temp_directory_path() / "test_split_empty";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+    REQUIRE_FALSE(translator.load_directory(directory));
+    REQUIRE_FALSE(translator.get_load_error().empty());
+    REQUIRE(translator.translate_view("home.title") == "Accueil");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Embedding tool splits embedded translations per locale")
+{
+    const std::filesystem::path k_test_output = std::filesystem::temp_directory_path() / "test_split.cxx";
+
+    // Run the embedding tool
+    std::string command = std::string(EMBED_TOOL_PATH) + " --split-locales " + TEST_DATA_FILE + " " + k_test_output.string();
+    REQUIRE(std::system(command.c_str()) == 0);
+
+    // Read the generated file
+    {
+        std::ifstream in(k_test_output);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        // Verify each locale gets its own sections
+        REQUIRE(content.find("get_embedded_locales") != std::string::npos);
+        REQUIRE(content.find("constexpr embedded_locale embedded_locales[]") != std::string::npos);
+        REQUIRE(content.find("{ \"fr-FR\", { arena_1, locales_1, keys_1, index_1, matrix_1, {}, message_ops_1, messages_1, counts_1 } }") != std::string::npos);
+    }
+
+    // Cleanup
+    std::filesystem::remove(k_test_output);
+}
+
+TEST_CASE("Embedding tool compresses split embedded translations")
+{
+    const std::filesystem::path k_test_output = std::filesystem::temp_directory_path() / "test_split_compressed.cxx";
+
+    // Run the embedding tool
+    std::string command = std::string(EMBED_TOOL_PATH) + " --split-locales --compress " + TEST_DATA_FILE + " " + k_test_output.string();
+    REQUIRE(std::system(command.c_str()) == 0);
+
+    // Read the generated file
+    {
+        std::ifstream in(k_test_output);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        // Verify each locale references its compressed catalog instead of sections
+        REQUIRE(content.find("constexpr char compressed_1[]") != std::string::npos);
+        REQUIRE(content.find("{ \"fr-FR\", {}, compressed_1 }") != std::string::npos);
+        REQUIRE(content.find("arena_1") == std::string::npos);
+    }
+
+    // Cleanup
+    std::filesystem::remove(k_test_output);
+}
@@ -0,0 +1,153 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/sample-keys.hxx>
+#include <linguist/translator.hxx>
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("locale views share one catalog")
+{
+    std::string error;
+    const auto translations = linguist::catalog::from_string(
+        R"({ "greeting": { "en-US": "Hello", "fr-FR": "Bonjour", "es-ES": "Hola" }, "only.english": { "en-US": "English" } })", error);
+    REQUIRE(translations);
+    REQUIRE(error.empty());
+    REQUIRE(translations->get_available_locales() == std::vector<std::string>{ "en-US", "fr-FR", "es-ES" });
+
+    const auto french = translations->view("fr-FR");
+    const auto spanish = translations->view("es-MX");
+    REQUIRE(french.get_locale() == "fr-FR");
+    REQUIRE(french.translate_view("greeting") == "Bonjour");
+    REQUIRE(spanish.translate("greeting") == "Hola");
+    REQUIRE(spanish.translate_view("missing", "fallback") == "fallback");
+
+    // Views are copies of the same resolved chain
+    const auto copy = french;
+    REQUIRE(copy.translate_view("greeting") == french.translate_view("greeting"));
+    REQUIRE(copy.translate_view("greeting")->data() == french.translate_view("greeting")->data());
+
+    // The default locale is tried after the view's locale
+    const auto german = translations->view("de-DE", "en-US");
+    REQUIRE(german.translate_view("greeting") == "Hello");
+    REQUIRE(german.has_translation("only.english"));
+}
+
+TEST_CASE("catalog registry counts the translations of each locale")
+{
+    std::string error;
+    const auto translations = linguist::catalog::from_string(
+        R"({ "greeting": { "en-US": "Hello", "fr-FR": "Bonjour" }, "farewell": { "en-US": "Bye" }, "only.spanish": { "es-ES": "Hola" } })", error);
+    REQUIRE(translations);
+
+    const auto locales = translations->available_locales();
+    REQUIRE(locales.size() == 3);
+    REQUIRE(locales[0].locale == "en-US");
+    REQUIRE(locales[0].translated == 2);
+    REQUIRE(locales[1].locale == "fr-FR");
+    REQUIRE(locales[1].translated == 1);
+    REQUIRE(locales[2].locale == "es-ES");
+    REQUIRE(locales[2].translated == 1);
+
+    // Copies share the registry
+    const auto copy = *translations;
+    REQUIRE(copy.available_locales().data() == locales.data());
+
+    linguist::translator translator(*translations);
+    REQUIRE(translator.available_locales().data() == locales.data());
+}
+
+TEST_CASE("locale views outlive their catalog")
+{
+    std::optional<linguist::locale_view> view;
+    {
+        std::string error;
+        auto translations = linguist::catalog::from_string(R"({ "greeting": { "en-US": "Hello" } })", error);
+        REQUIRE(translations);
+        view = translations->view("en-US");
+    }
+
+    REQUIRE(view->translate_view("greeting") == "Hello");
+}
+
+TEST_CASE("catalog reports load errors")
+{
+    std::string error;
+    REQUIRE_FALSE(linguist::catalog::from_string("{ invalid json }", error));
+    REQUIRE_FALSE(error.empty());
+
+    error.clear();
+    REQUIRE_FALSE(linguist::catalog::from_file("missing-translations.json", error));
+    REQUIRE(error.find("cannot open") != std::string::npos);
+
+    // An empty catalog translates nothing
+    const linguist::catalog empty;
+    REQUIRE(empty.get_available_locales().empty());
+    REQUIRE(empty.available_locales().empty());
+    REQUIRE_FALSE(empty.view("en-US").translate_view("home.title").has_value());
+}
+
+TEST_CASE("embedded catalog resolves key handles")
+{
+    const auto view = linguist::catalog::embedded().view("es-ES");
+    REQUIRE(view.translate_view(linguist::keys::home_title) == "Inicio");
+    REQUIRE(view.translate(linguist::keys::button_save, "Save") == "Guardar");
+}
+
+TEST_CASE("translators share a catalog without copying it")
+{
+    std::string error;
+    const auto translations = linguist::catalog::from_string(R"({ "greeting": { "en-US": "Hello", "fr-FR": "Bonjour" } })", error);
+    REQUIRE(translations);
+
+    linguist::translator english(*translations);
+    english.set_locale("en-US");
+    linguist::translator french;
+    french.set_catalog(english.get_catalog());
+    french.set_locale("fr-FR");
+
+    REQUIRE(english.translate_view("greeting") == "Hello");
+    REQUIRE(french.translate_view("greeting") == "Bonjour");
+    REQUIRE(english.snapshot()->translate_view("greeting", "fr-FR", true)->data() == french.translate_view("greeting")->data());
+}
+
+TEST_CASE("threads translate different locales from one catalog")
+{
+    constexpr std::array<const char*, 3> k_locales = { "en-US", "fr-FR", "es-ES" };
+    constexpr std::array<const char*, 3> k_expected = { "Home", "Accueil", "Inicio" };
+    constexpr std::size_t k_lookup_count = 1000;
+
+    const auto& translations = linguist::catalog::embedded();
+    std::atomic<std::size_t> failures{ 0 };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < k_locales.size(); ++i)
+    {
+        threads.emplace_back(
+            [&, i]()
+            {
+                const auto view = translations.view(k_locales[i]);
+                for (std::size_t lookup = 0; lookup < k_lookup_count; ++lookup)
+                {
+                    if (view.translate_view("home.title") != k_expected[i])
+                    {
+                        failures.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(failures.load() == 0);
+}
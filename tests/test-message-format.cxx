@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/sample-keys.hxx>
+#include <linguist/translation-catalog.hxx>
+#include <linguist/translator.hxx>
+
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+static auto format(std::string_view pattern, std::span<const linguist::message_argument> arguments, std::string_view locale = "en-US")
+    -> std::string
+{
+    std::vector<linguist::message_op> ops;
+    std::string error;
+    REQUIRE(linguist::compile_message(pattern, ops, error));
+    return linguist::message(pattern, ops).format(arguments, linguist::plural_rule_for(locale));
+}
+
+TEST_CASE("messages substitute named placeholders")
+{
+    const std::array<linguist::message_argument, 2> arguments = { { { "name", "Ada" }, { "count", 42 } } };
+    REQUIRE(format("Hello {name}!", arguments) == "Hello Ada!");
+    REQUIRE(format("{ name } has {count, number} points", arguments) == "Ada has 42 points");
+    REQUIRE(format("Hello {missing}", arguments) == "Hello {missing}");
+}
+
+TEST_CASE("messages select plural forms by locale")
+{
+    const std::string_view english = "{count, plural, =0 {no files} one {# file} other {# files}}";
+    REQUIRE(format(english, std::array{ linguist::message_argument("count", 0) }) == "no files");
+    REQUIRE(format(english, std::array{ linguist::message_argument("count", 1) }) == "1 file");
+    REQUIRE(format(english, std::array{ linguist::message_argument("count", 7u) }) == "7 files");
+
+    // Zero is singular in French
+    const std::string_view french = "{count, plural, one {# fichier} other {# fichiers}}";
+    REQUIRE(format(french, std::array{ linguist::message_argument("count", 0) }, "fr-FR") == "0 fichier");
+
+    const std::string_view russian = "{count, plural, one {# файл} few {# файла} many {# файлов} other {# файла}}";
+    REQUIRE(format(russian, std::array{ linguist::message_argument("count", 21) }, "ru-RU") == "21 файл");
+    REQUIRE(format(russian, std::array{ linguist::message_argument("count", 22) }, "ru-RU") == "22 файла");
+    REQUIRE(format(russian, std::array{ linguist::message_argument("count", 11) }, "ru-RU") == "11 файлов");
+}
+
+TEST_CASE("messages select cases and nest them")
+{
+    const std::string_view pattern = "{gender, select, female {She has {count, plural, one {# cat} other {# cats}}} other {They have # cats}}";
+    REQUIRE(format(pattern, std::array{ linguist::message_argument("gender", "female"), linguist::message_argument("count", 1) }) == "She has 1 cat");
+    REQUIRE(format(pattern, std::array{ linguist::message_argument("gender", "male"), linguist::message_argument("count", 2) }) == "They have # cats");
+}
+
+TEST_CASE("messages resolve apostrophe quoting")
+{
+    const std::array<linguist::message_argument, 1> arguments = { { { "count", 3 } } };
+    REQUIRE(format("It''s '{literal}' and don't", arguments) == "It's {literal} and don't");
+    REQUIRE(format("{count, plural, other {'#' is #}}", arguments) == "# is 3");
+}
+
+TEST_CASE("malformed messages are rejected")
+{
+    for (const std::string_view pattern : { "{", "}", "{count, plural, one {# file}}", "{count, date}", "{count, plural, some {x} other {y}}",
+             "{count, select, other {unterminated}" })
+    {
+        std::vector<linguist::message_op> ops;
+        std::string error;
+        REQUIRE_FALSE(linguist::compile_message(pattern, ops, error));
+        REQUIRE(ops.empty());
+        REQUIRE_FALSE(error.empty());
+    }
+}
+
+TEST_CASE("compiled messages are checked before formatting")
+{
+    const std::string_view pattern = "{gender, select, female {{count, plural, =0 {none} one {# cat} other {# cats}}} other {They}}";
+    std::vector<linguist::message_op> compiled;
+    std::string error;
+    REQUIRE(linguist::compile_message(pattern, compiled, error));
+    REQUIRE(linguist::is_valid_message(pattern, compiled));
+    REQUIRE(linguist::is_valid_message("plain", {}));
+
+    // Change one operation of the compiled message
+    const auto is_valid_with = [&](std::size_t index, auto&& change)
+    {
+        auto ops = compiled;
+        change(ops[index]);
+        return linguist::is_valid_message(pattern, ops);
+    };
+
+    // The select, the plural and their cases
+    REQUIRE(compiled[0].code == linguist::message_opcode::select);
+    REQUIRE(compiled[2].code == linguist::message_opcode::plural);
+    const std::size_t other_case = 8;
+    REQUIRE(compiled[other_case].code == linguist::message_opcode::plural_case);
+    REQUIRE(compiled[other_case].value == static_cast<std::uint32_t>(linguist::plural_category::other));
+
+    // A plural or select must keep its "other" case
+    REQUIRE_FALSE(is_valid_with(other_case, [](auto& op) { op.value = static_cast<std::uint32_t>(linguist::plural_category::many); }));
+    REQUIRE_FALSE(is_valid_with(other_case, [](auto& op) { op.code = linguist::message_opcode::exact_case; }));
+    REQUIRE_FALSE(is_valid_with(compiled.size() - 2, [&](auto& op) { op.offset = static_cast<std::uint32_t>(pattern.find("female")); }));
+
+    // Cases appear only directly under a plural or select of their kind, and nothing else does
+    REQUIRE_FALSE(is_valid_with(0, [](auto& op) { op.code = linguist::message_opcode::select_case; }));
+    REQUIRE_FALSE(is_valid_with(2, [](auto& op) { op.code = linguist::message_opcode::select; }));
+    REQUIRE_FALSE(is_valid_with(3, [](auto& op) { op.code = linguist::message_opcode::text; }));
+    REQUIRE_FALSE(is_valid_with(other_case, [](auto& op) { op.code = linguist::message_opcode::select_case; }));
+
+    // Scopes end ahead of themselves and within their enclosing scope
+    REQUIRE_FALSE(is_valid_with(2, [](auto& op) { op.end = 2; }));
+    REQUIRE_FALSE(is_valid_with(2, [](auto& op) { op.end = 3; }));
+    REQUIRE_FALSE(is_valid_with(other_case, [&](auto& op) { op.end = static_cast<std::uint32_t>(compiled.size()); }));
+    REQUIRE_FALSE(is_valid_with(1, [](auto& op) { op.size = 1000; }));
+}
+
+TEST_CASE("messages format into a caller buffer and report truncation")
+{
+    std::vector<linguist::message_op> ops;
+    std::string error;
+    const std::string_view pattern = "Hello {name}!";
+    REQUIRE(linguist::compile_message(pattern, ops, error));
+
+    const linguist::message message(pattern, ops);
+    const std::array arguments = { linguist::message_argument("name", "World") };
+    std::array<char, 8> buffer{};
+    REQUIRE(message.format_to(buffer, arguments, linguist::plural_rule_for("en-US")) == 12);
+    REQUIRE(std::string_view(buffer.data(), buffer.size()) == "Hello Wo");
+}
+
+TEST_CASE("translation tables precompile messages")
+{
+    linguist::translation_table::builder builder;
+    builder.add("cart", "en-US", "{count, plural, one {# item} other {# items}}");
+    builder.add("plain", "en-US", "Don't stop");
+    builder.add("broken", "en-US", "{count");
+    const auto table = builder.build();
+
+    const auto locale = *table.find_locale("en-US");
+    const auto cart = table.find_message(*table.text(table.find("cart"), locale));
+    REQUIRE(cart.has_value());
+    REQUIRE_FALSE(cart->ops().empty());
+
+    // Plain and malformed texts are formatted as they are
+    const auto plain = table.find_message(*table.text(table.find("plain"), locale));
+    REQUIRE(plain->ops().empty());
+    REQUIRE(table.find_message(*table.text(table.find("broken"), locale))->ops().empty());
+    REQUIRE_FALSE(table.find_message("not in the table").has_value());
+
+    // Messages survive a binary catalog round trip
+    std::ostringstream output(std::ios::binary);
+    linguist::write_catalog(output, table);
+    const auto bytes = output.str();
+    std::vector<std::uint64_t> storage((bytes.size() + 7) / 8);
+    std::memcpy(storage.data(), bytes.data(), bytes.size());
+
+    const linguist::translation_table mapped(*linguist::read_catalog({ reinterpret_cast<const char*>(storage.data()), bytes.size() }));
+    const auto message = mapped.find_message(*mapped.text(mapped.find("cart"), locale));
+    REQUIRE(message->format(std::array{ linguist::message_argument("count", 2) }, linguist::plural_rule_for("en-US")) == "2 items");
+}
+
+TEST_CASE("translator formats loaded and embedded messages")
+{
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+
+    // Embedded messages are compiled by the embed tool
+    const std::array empty = { linguist::message_argument("count", 0) };
+    const std::array one = { linguist::message_argument("count", 1) };
+    REQUIRE(translator.format(linguist::keys::cart_items, empty) == "Votre panier est vide");
+    REQUIRE(translator.format("cart.items", one) == "1 article dans votre panier");
+
+    std::array<char, 64> buffer{};
+    const auto size = translator.format_to(linguist::keys::cart_items, buffer, std::array{ linguist::message_argument("count", 3) });
+    REQUIRE(size.has_value());
+    REQUIRE(std::string_view(buffer.data(), *size) == "3 articles dans votre panier");
+    REQUIRE_FALSE(translator.format("missing", one).has_value());
+
+    // Loaded messages are compiled by the loader
+    REQUIRE(translator.load_from_string(R"({ "greeting": { "en-US": "Hello {name}", "fr-FR": "Bonjour {name}" } })"));
+    REQUIRE(translator.format("greeting", std::array{ linguist::message_argument("name", "Ada") }) == "Bonjour Ada");
+
+    const auto view = translator.get_catalog().view("en-GB");
+    REQUIRE(view.format("greeting", std::array{ linguist::message_argument("name", "Ada") }) == "Hello Ada");
+}
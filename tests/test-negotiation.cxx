@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/translator.hxx>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <catch2/catch_test_macros.hpp>
+
+/// Catalog of French, Swiss German, traditional Chinese and English translations
+static auto make_catalog() -> linguist::catalog
+{
+    std::string error;
+    auto translations = linguist::catalog::from_string(R"({
+        "greeting": { "fr-FR": "Bonjour", "de-CH": "Grüezi", "zh-Hant": "你好", "en": "Hello" }
+    })",
+        error);
+    REQUIRE(translations);
+    return *translations;
+}
+
+/// Negotiate a preference list against a catalog without the negotiator's cache
+static auto best_locale(const linguist::catalog& translations, std::string_view preferences) -> std::optional<std::string_view>
+{
+    std::array<linguist::weighted_locale, 8> ranges;
+    const auto count = linguist::parse_locale_preferences(preferences, ranges);
+    const auto index = linguist::match_locale(std::span(ranges.data(), count), translations.available_locales());
+    return index ? std::optional(translations.available_locales()[*index].locale) : std::nullopt;
+}
+
+TEST_CASE("preference lists are parsed by decreasing quality")
+{
+    std::array<linguist::weighted_locale, 8> ranges;
+    const auto count = linguist::parse_locale_preferences(" en;q=0.8 , fr-CH,fr;q=0.9, de;Q=0.8;level=1, *;q=0.5, es;q=0", ranges);
+    REQUIRE(count == 4);
+    REQUIRE(ranges[0].locale == "fr-CH");
+    REQUIRE(ranges[0].quality == 1000);
+    REQUIRE(ranges[1].locale == "fr");
+    REQUIRE(ranges[1].quality == 900);
+    REQUIRE(ranges[2].locale == "en");
+    REQUIRE(ranges[2].quality == 800);
+    REQUIRE(ranges[3].locale == "de");
+    REQUIRE(ranges[3].quality == 800);
+
+    // Malformed ranges and weights are skipped
+    REQUIRE(linguist::parse_locale_preferences("", ranges) == 0);
+    REQUIRE(linguist::parse_locale_preferences(",,;q=1, en--US, -en, 1en, en;q=2, en;q=0.0001, en;q=x", ranges) == 0);
+    REQUIRE(linguist::parse_locale_preferences("en;q=1.000, fr;q=0.5, de;q=1, es;q=0.", ranges) == 3);
+    REQUIRE(ranges[1].locale == "de");
+    REQUIRE(ranges[2].quality == 500);
+}
+
+TEST_CASE("preference lists keep their highest weighted ranges")
+{
+    std::array<linguist::weighted_locale, 2> ranges;
+    REQUIRE(linguist::parse_locale_preferences("da;q=0.1, fr;q=0.5, en;q=0.7, de;q=0.2", ranges) == 2);
+    REQUIRE(ranges[0].locale == "en");
+    REQUIRE(ranges[1].locale == "fr");
+}
+
+TEST_CASE("preferences match available locales with BCP 47 lookup")
+{
+    const auto translations = make_catalog();
+
+    // Exact match, ignoring case and separators
+    REQUIRE(best_locale(translations, "de_ch") == "de-CH");
+
+    // Truncated one subtag at a time
+    REQUIRE(best_locale(translations, "zh-Hant-TW") == "zh-Hant");
+    REQUIRE(best_locale(translations, "en-x-private") == "en");
+    REQUIRE(best_locale(translations, "en-GB") == "en");
+
+    // Failing that, a regional variant of the same language
+    REQUIRE(best_locale(translations, "fr-CH, en;q=0.8") == "fr-FR");
+    REQUIRE(best_locale(translations, "de") == "de-CH");
+
+    // Higher weights win over earlier ranges
+    REQUIRE(best_locale(translations, "es, en;q=0.5, fr;q=0.9") == "fr-FR");
+    REQUIRE_FALSE(best_locale(translations, "es, it;q=0.9, *").has_value());
+}
+
+TEST_CASE("locale negotiator caches views per preference list")
+{
+    const linguist::locale_negotiator negotiator(make_catalog(), "en", 2);
+
+    const auto french = negotiator.negotiate("fr-CH, fr;q=0.9, en;q=0.8");
+    REQUIRE(french.get_locale() == "fr-FR");
+    REQUIRE(french.translate_view("greeting") == "Bonjour");
+    REQUIRE(negotiator.find_locale("fr-CH, fr;q=0.9, en;q=0.8") == "fr-FR");
+
+    // The same header resolves to the same cached view
+    const auto again = negotiator.negotiate("fr-CH, fr;q=0.9, en;q=0.8");
+    REQUIRE(again.translate_view("greeting")->data() == french.translate_view("greeting")->data());
+
+    // Unmatched preferences fall back to the default locale
+    const auto fallback = negotiator.negotiate("es-ES");
+    REQUIRE(fallback.get_locale() == "en");
+    REQUIRE(fallback.translate_view("greeting") == "Hello");
+    REQUIRE_FALSE(negotiator.find_locale("es-ES").has_value());
+
+    // A full cache is cleared, and still negotiates
+    REQUIRE(negotiator.negotiate("de-CH").translate_view("greeting") == "Grüezi");
+    REQUIRE(negotiator.negotiate("fr-CH, fr;q=0.9, en;q=0.8").get_locale() == "fr-FR");
+}
+
+TEST_CASE("translator sets the best locale of a preference list")
+{
+    linguist::translator translator(make_catalog());
+    translator.set_locale("en");
+
+    REQUIRE(translator.set_preferred_locales("zh-Hant-HK, en;q=0.5"));
+    REQUIRE(translator.get_locale() == "zh-Hant");
+    REQUIRE(translator.translate_view("greeting") == "你好");
+
+    REQUIRE_FALSE(translator.set_preferred_locales("es, it;q=0.5"));
+    REQUIRE(translator.get_locale() == "zh-Hant");
+
+    // Long lists are not truncated, so a match weighted below many unavailable ranges is found
+    std::string preferences;
+    for (char letter = 'a'; letter < 'u'; ++letter)
+    {
+        preferences += std::string{ 'q', letter } + ", ";
+    }
+    REQUIRE(translator.set_preferred_locales(preferences + "fr;q=0.1"));
+    REQUIRE(translator.get_locale() == "fr-FR");
+}
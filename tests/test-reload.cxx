@@ -0,0 +1,245 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/translator.hxx>
+
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+/// Catalog whose every translation is the version number
+static auto make_version(std::size_t version) -> std::string
+{
+    const auto text = std::to_string(version);
+    return R"({ "first": { "en-US": ")" + text + R"(", "fr-FR": ")" + text + R"(" }, "second": { "en-US": ")" + text + R"(", "fr-FR": ")" +
+        text + R"(" } })";
+}
+
+TEST_CASE("snapshot views stay valid across reloads")
+{
+    linguist::translator translator;
+    translator.set_locale("en-US");
+    REQUIRE(translator.load_from_string(make_version(1)));
+
+    const auto snapshot = translator.snapshot();
+    const auto view = snapshot->translate_view("first");
+    REQUIRE(view == "1");
+
+    REQUIRE(translator.load_from_string(make_version(2)));
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.translate_view("first") == "2");
+
+    // The old snapshot still holds the first version
+    REQUIRE(view == "1");
+    REQUIRE(snapshot->translate_view("second") == "1");
+}
+
+TEST_CASE("readers never see a torn table while translations are reloaded")
+{
+    constexpr std::size_t k_reader_count = 4;
+    constexpr std::size_t k_reload_count = 200;
+
+    std::vector<std::string> versions;
+    for (std::size_t version = 0; version < k_reload_count; ++version)
+    {
+        versions.push_back(make_version(version));
+    }
+
+    linguist::translator translator;
+    translator.set_locale("en-US");
+    REQUIRE(translator.load_from_string(versions[0]));
+
+    std::atomic<bool> done{ false };
+    std::atomic<std::size_t> lookups{ 0 };
+    std::atomic<std::size_t> failures{ 0 };
+
+    std::vector<std::thread> readers;
+    for (std::size_t reader = 0; reader < k_reader_count; ++reader)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    // Both identifiers come from the same version within one snapshot
+                    const auto snapshot = translator.snapshot();
+                    const auto first = snapshot->translate_view("first");
+                    const auto second = snapshot->translate_view("second");
+                    if (!first || first != second)
+                    {
+                        failures.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    // Copies are taken from a consistent table
+                    if (!translator.translate("first").has_value())
+                    {
+                        failures.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    lookups.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+    }
+
+    // Reload and switch locales continuously while the readers run
+    bool reloaded = true;
+    for (std::size_t version = 1; version < k_reload_count; ++version)
+    {
+        reloaded = reloaded && translator.load_from_string(versions[version]);
+        translator.set_locale(version % 2 == 0 ? "en-US" : "fr-FR");
+    }
+
+    done = true;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    REQUIRE(reloaded);
+    REQUIRE(lookups.load() > 0);
+    REQUIRE(failures.load() == 0);
+    REQUIRE(translator.translate_view("first") == std::to_string(k_reload_count - 1));
+}
+
+TEST_CASE("reloads free the previous translations while other threads idle")
+{
+    std::string error;
+    auto first = linguist::catalog::from_string(make_version(1), error);
+    REQUIRE(first);
+
+    std::weak_ptr<const linguist::translation_snapshot> previous;
+    std::atomic<bool> looked_up{ false };
+    std::atomic<bool> done{ false };
+    std::thread reader;
+    {
+        linguist::translator translator(std::move(*first));
+        translator.set_locale("en-US");
+        previous = translator.snapshot();
+
+        // A thread looks up once, then idles without looking up again
+        reader = std::thread(
+            [&]()
+            {
+                const auto translation = translator.translate("first");
+                looked_up = translation == "1";
+                while (!done)
+                {
+                    std::this_thread::yield();
+                }
+            });
+
+        while (!looked_up)
+        {
+            std::this_thread::yield();
+        }
+
+        REQUIRE_FALSE(previous.expired());
+        REQUIRE(translator.load_from_string(make_version(2)));
+        REQUIRE(previous.expired());
+        previous = translator.snapshot();
+    }
+
+    // Destroying the translator frees its translations, although the thread is still running
+    REQUIRE(previous.expired());
+    done = true;
+    reader.join();
+}
+
+TEST_CASE("translations load on a background thread")
+{
+    linguist::translator translator{ linguist::catalog() };
+    translator.set_locale("en-US");
+
+    auto loaded = translator.load_from_string_async(make_version(1));
+
+    // Until the load is published, lookups return their fallback
+    const auto early = translator.translate_view("first", "fallback");
+    REQUIRE((early == "fallback" || early == "1"));
+
+    REQUIRE(loaded.get());
+    REQUIRE(translator.translate_view("first") == "1");
+    REQUIRE(translator.get_load_error().empty());
+
+    // Locale changes made while loading apply to the published translations
+    auto reloaded = translator.load_from_string_async(make_version(2));
+    translator.set_locale("fr-FR");
+    translator.wait_for_loads();
+    REQUIRE(reloaded.get());
+    REQUIRE(translator.snapshot()->get_locale() == "fr-FR");
+    REQUIRE(translator.translate_view("first") == "2");
+}
+
+TEST_CASE("failed background loads keep the current translations")
+{
+    linguist::translator translator{ linguist::catalog() };
+    translator.set_locale("en-US");
+    REQUIRE(translator.load_from_string(make_version(1)));
+
+    REQUIRE_FALSE(translator.load_from_string_async("{ invalid").get());
+    REQUIRE_FALSE(translator.get_load_error().empty());
+
+    // The error can be read while another load replaces it
+    auto failing = translator.load_from_string_async("{ \"first\": ");
+    for (int read = 0; read < 100; ++read)
+    {
+        REQUIRE_FALSE(translator.get_load_error().empty());
+    }
+
+    REQUIRE_FALSE(failing.get());
+    REQUIRE_FALSE(translator.load_from_file_async(std::filesystem::temp_directory_path() / "linguist-missing.json").get());
+    REQUIRE_FALSE(translator.load_directory_async(std::filesystem::temp_directory_path() / "linguist-missing").get());
+    REQUIRE(translator.translate_view("first") == "1");
+}
+
+TEST_CASE("loads are published in the order they were started")
+{
+    linguist::translator translator{ linguist::catalog() };
+    translator.set_locale("en-US");
+
+    // Whichever finishes first, the later load's translations stay
+    std::vector<std::shared_future<bool>> loads;
+    for (std::size_t version = 1; version <= 8; ++version)
+    {
+        loads.push_back(translator.load_from_string_async(make_version(version)));
+    }
+
+    REQUIRE(translator.load_from_string(make_version(9)));
+    translator.wait_for_loads();
+    REQUIRE(translator.translate_view("first") == "9");
+
+    // An asynchronous load started last wins over the synchronous one
+    auto last = translator.load_from_string_async(make_version(10));
+    REQUIRE(last.get());
+    REQUIRE(translator.translate_view("first") == "10");
+}
+
+TEST_CASE("translators wait for their background loads")
+{
+    {
+        // Dropping the future neither blocks nor loses the load
+        linguist::translator translator(linguist::background_load);
+        (void)translator.load_from_string_async(make_version(1));
+    }
+
+    linguist::translator translator(linguist::background_load);
+    translator.set_locale("fr-FR");
+    translator.wait_for_loads();
+    REQUIRE(translator.translate_view("home.title") == "Accueil");
+
+    // Moving waits for the loads publishing into the source
+    auto loaded = translator.load_from_string_async(make_version(3));
+    linguist::translator moved(std::move(translator));
+    REQUIRE(loaded.get());
+    REQUIRE(moved.translate_view("first") == "3");
+
+    // Moving a translator into itself keeps its translations
+    auto& same = moved;
+    moved = std::move(same);
+    REQUIRE(moved.translate_view("first") == "3");
+    REQUIRE(moved.get_locale() == "fr-FR");
+}
@@ -0,0 +1,230 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/sample-keys.hxx>
+#include <linguist/translator.hxx>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+using linguist::lookup_result;
+
+/// Translator for en-US over translations found exactly, through a regional variant, in another language only, or not at all
+static auto make_translator() -> linguist::translator
+{
+    linguist::translator translator;
+    translator.set_locale("en-US");
+    REQUIRE(translator.load_from_string(R"({
+        "greeting": { "en-US": "Hello", "en-GB": "Hiya", "fr-FR": "Bonjour" },
+        "colour": { "en-GB": "Colour" },
+        "only.german": { "de-DE": "Nur Deutsch" }
+    })"));
+    return translator;
+}
+
+TEST_CASE("statistics are not collected unless enabled")
+{
+    const auto translator = make_translator();
+    REQUIRE(translator.translate_view("greeting") == "Hello");
+
+    const auto statistics = translator.get_statistics();
+    REQUIRE_FALSE(statistics.enabled);
+    REQUIRE(statistics.lookups() == 0);
+}
+
+#if LINGUIST_STATISTICS
+
+TEST_CASE("statistics count lookups by how they were resolved")
+{
+    auto translator = make_translator();
+    translator.enable_statistics();
+
+    REQUIRE(translator.translate_view("greeting") == "Hello");
+    REQUIRE(translator.translate_view("colour") == "Colour");
+    REQUIRE(translator.translate_view("only.german") == "Nur Deutsch");
+    REQUIRE_FALSE(translator.translate_view("missing").has_value());
+    REQUIRE_FALSE(translator.has_translation("missing"));
+
+    const auto statistics = translator.get_statistics();
+    REQUIRE(statistics.enabled);
+    REQUIRE(statistics.count(lookup_result::exact) == 1);
+    REQUIRE(statistics.count(lookup_result::base_language) == 1);
+    REQUIRE(statistics.count(lookup_result::any_locale) == 1);
+    REQUIRE(statistics.count(lookup_result::missing) == 2);
+    REQUIRE(statistics.lookups() == 5);
+
+    // Statistics carry over locale changes and reloads
+    translator.set_locale("fr-FR");
+    REQUIRE(translator.translate_view("greeting") == "Bonjour");
+    REQUIRE(translator.get_statistics().count(lookup_result::exact) == 2);
+
+    // Without the exact locale, the first step of the chain is a fallback
+    translator.set_locale("en-AU");
+    REQUIRE(translator.translate_view("greeting") == "Hello");
+    REQUIRE(translator.get_statistics().count(lookup_result::base_language) == 2);
+}
+
+TEST_CASE("statistics count batch, key and explicit locale lookups")
+{
+    linguist::translator translator;
+    translator.set_locale("fr-FR");
+    translator.enable_statistics();
+
+    REQUIRE(translator.translate_view(linguist::keys::home_title) == "Accueil");
+    REQUIRE(translator.translate("home.title", "es-ES", true) == "Inicio");
+    REQUIRE_FALSE(translator.translate("home.title", "de-DE", true).has_value());
+
+    const std::array<std::string_view, 3> identifiers = { "home.title", "missing", "button.save" };
+    std::array<std::optional<std::string_view>, 3> translations;
+    translator.snapshot()->translate_batch(identifiers, translations);
+    REQUIRE(translations[0] == "Accueil");
+    REQUIRE_FALSE(translations[1].has_value());
+
+    const auto statistics = translator.get_statistics();
+    REQUIRE(statistics.count(lookup_result::exact) == 4);
+    REQUIRE(statistics.count(lookup_result::missing) == 2);
+    REQUIRE(statistics.missing_keys.size() == 2);
+}
+
+TEST_CASE("statistics track the most frequently missing identifiers")
+{
+    auto translator = make_translator();
+    translator.enable_statistics({ .missing_keys = 2 });
+
+    for (const auto* identifier : { "often", "once", "often", "sometimes", "often", "sometimes" })
+    {
+        REQUIRE_FALSE(translator.translate_view(identifier).has_value());
+    }
+
+    // "sometimes" displaced "once" and inherited its count
+    const auto statistics = translator.get_statistics();
+    REQUIRE(statistics.missing_keys.size() == 2);
+    REQUIRE(statistics.missing_keys[0].identifier == "often");
+    REQUIRE(statistics.missing_keys[0].count == 3);
+    REQUIRE(statistics.missing_keys[1].identifier == "sometimes");
+    REQUIRE(statistics.missing_keys[1].count == 3);
+}
+
+TEST_CASE("statistics sample lookup latencies")
+{
+    auto translator = make_translator();
+    translator.enable_statistics({ .latency_sample_interval = 1 });
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        REQUIRE(translator.translate_view("greeting") == "Hello");
+    }
+
+    auto statistics = translator.get_statistics();
+    REQUIRE(statistics.latency_samples() == 100);
+    REQUIRE(statistics.latency_quantile(0.5) > 0);
+    REQUIRE(statistics.latency_quantile(0.5) <= statistics.latency_quantile(0.99));
+
+    // Intervals are rounded up to a power of two
+    translator.enable_statistics({ .latency_sample_interval = 3 });
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        REQUIRE(translator.translate_view("greeting") == "Hello");
+    }
+
+    statistics = translator.get_statistics();
+    REQUIRE(statistics.lookups() == 100);
+    REQUIRE(statistics.latency_samples() == 25);
+}
+
+TEST_CASE("statistics can be reset and disabled")
+{
+    auto translator = make_translator();
+    translator.enable_statistics();
+    REQUIRE_FALSE(translator.translate_view("missing").has_value());
+
+    translator.reset_statistics();
+    auto statistics = translator.get_statistics();
+    REQUIRE(statistics.enabled);
+    REQUIRE(statistics.lookups() == 0);
+    REQUIRE(statistics.missing_keys.empty());
+
+    translator.disable_statistics();
+    REQUIRE(translator.translate_view("greeting") == "Hello");
+    REQUIRE_FALSE(translator.get_statistics().enabled);
+}
+
+TEST_CASE("statistics count lookups from every thread")
+{
+    auto translator = make_translator();
+    translator.enable_statistics({ .latency_sample_interval = 16 });
+
+    std::vector<std::thread> readers;
+    for (std::size_t thread = 0; thread < 4; ++thread)
+    {
+        readers.emplace_back(
+            [&translator]
+            {
+                for (std::size_t i = 0; i < 1000; ++i)
+                {
+                    (void)translator.translate_view(i % 2 == 0 ? "greeting" : "missing");
+                }
+            });
+    }
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    const auto statistics = translator.get_statistics();
+    REQUIRE(statistics.count(lookup_result::exact) == 2000);
+    REQUIRE(statistics.count(lookup_result::missing) == 2000);
+    REQUIRE(statistics.missing_keys.size() == 1);
+    REQUIRE(statistics.missing_keys[0].count == 2000);
+}
+
+TEST_CASE("statistics merge the missing identifiers of every thread")
+{
+    auto translator = make_translator();
+    translator.enable_statistics({ .missing_keys = 2 });
+
+    // Each thread misses a shared identifier often and one of its own once
+    std::vector<std::thread> readers;
+    for (std::size_t thread = 0; thread < 4; ++thread)
+    {
+        readers.emplace_back(
+            [&translator, thread]
+            {
+                for (std::size_t i = 0; i < 10; ++i)
+                {
+                    (void)translator.translate_view("shared");
+                }
+
+                (void)translator.translate_view("own." + std::to_string(thread));
+            });
+    }
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    const auto statistics = translator.get_statistics();
+    REQUIRE(statistics.missing_keys.size() == 2);
+    REQUIRE(statistics.missing_keys[0].identifier == "shared");
+    REQUIRE(statistics.missing_keys[0].count == 40);
+    REQUIRE(statistics.missing_keys[1].identifier.starts_with("own."));
+}
+
+#else
+
+TEST_CASE("statistics compiled out are never enabled")
+{
+    auto translator = make_translator();
+    translator.enable_statistics();
+    REQUIRE(translator.translate_view("greeting") == "Hello");
+    REQUIRE_FALSE(translator.get_statistics().enabled);
+}
+
+#endif
@@ -0,0 +1,245 @@
+//
+// Copyright (c) 2026 Jamie Kenyon. All Rights Reserved.
+//
+
+#include <linguist/translation-table.hxx>
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("translation table starts empty")
+{
+    const linguist::translation_table table;
+    REQUIRE(table.empty());
+    REQUIRE(table.size() == 0);
+    REQUIRE(table.locale_count() == 0);
+    REQUIRE(table.find("any.key") == linguist::translation_table::npos);
+    REQUIRE(!table.find_locale("en-US").has_value());
+}
+
+TEST_CASE("translation table interns identifiers and locales")
+{
+    linguist::translation_table::builder builder;
+    builder.add("home.title", "en-US", "Home");
+    builder.add("home.title", "fr-FR", "Accueil");
+    builder.add("button.save", "en-US", "Save");
+
+    const auto table = builder.build();
+    REQUIRE(table.size() == 2);
+    REQUIRE(table.locale_count() == 2);
+
+    const auto en = table.find_locale("en-US");
+    const auto fr = table.find_locale("fr-FR");
+    REQUIRE(en.has_value());
+    REQUIRE(fr.has_value());
+    REQUIRE(table.locale(*en) == "en-US");
+    REQUIRE(table.locale(*fr) == "fr-FR");
+
+    const auto home = table.find("home.title");
+    const auto save = table.find("button.save");
+    REQUIRE(home != linguist::translation_table::npos);
+    REQUIRE(save != linguist::translation_table::npos);
+    REQUIRE(table.text(home, *en) == "Home");
+    REQUIRE(table.text(home, *fr) == "Accueil");
+    REQUIRE(table.text(save, *en) == "Save");
+    REQUIRE(!table.text(save, *fr).has_value());
+    REQUIRE(table.first_text(save) == "Save");
+    REQUIRE(table.find("home") == linguist::translation_table::npos);
+
+    REQUIRE(table.translated_count(*en) == 2);
+    REQUIRE(table.translated_count(*fr) == 1);
+    REQUIRE(table.translated_count(2) == 0);
+}
+
+TEST_CASE("translation table stores identical texts once")
+{
+    linguist::translation_table::builder builder;
+    builder.add("button.ok", "en-US", "OK");
+    builder.add("button.ok", "fr-FR", "OK");
+    builder.add("dialog.ok", "en-US", "OK");
+
+    const auto table = builder.build();
+    const auto en = *table.find_locale("en-US");
+    const auto fr = *table.find_locale("fr-FR");
+
+    const auto first = table.text(table.find("button.ok"), en);
+    const auto second = table.text(table.find("button.ok"), fr);
+    const auto third = table.text(table.find("dialog.ok"), en);
+    REQUIRE(first->data() == second->data());
+    REQUIRE(first->data() == third->data());
+}
+
+TEST_CASE("translation table keeps the latest duplicate translation")
+{
+    linguist::translation_table::builder builder;
+    builder.add("test.key", "en-US", "First");
+    builder.add("test.key", "en-US", "Second");
+
+    const auto table = builder.build();
+    REQUIRE(table.size() == 1);
+    REQUIRE(table.text(table.find("test.key"), *table.find_locale("en-US")) == "Second");
+}
+
+TEST_CASE("translation table finds many identifiers")
+{
+    linguist::translation_table::builder builder;
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        builder.add("key." + std::to_string(i), "en-US", "Value " + std::to_string(i));
+    }
+
+    const auto table = builder.build();
+    const auto en = *table.find_locale("en-US");
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        const auto row = table.find("key." + std::to_string(i));
+        REQUIRE(row != linguist::translation_table::npos);
+        REQUIRE(table.text(row, en) == "Value " + std::to_string(i));
+    }
+
+    REQUIRE(table.find("key.1000") == linguist::translation_table::npos);
+}
+
+TEST_CASE("identifier hashes are the same on every host")
+{
+    // Binary catalogs and embedded tables store indexes built with these hashes
+    REQUIRE(linguist::hash_identifier("") == 0xFA303ABC2B1D7630ull);
+    REQUIRE(linguist::hash_identifier("a") == 0xC80A9828E7DB8439ull);
+    REQUIRE(linguist::hash_identifier("home.title") == 0x7C075288D4CD744Dull);
+    REQUIRE(linguist::hash_identifier("settings.account.privacy.title") == 0xFDD3AAEC97F03568ull);
+    REQUIRE(linguist::hash_identifier(std::string(100, 'x')) == 0xA592436D8872F839ull);
+}
+
+TEST_CASE("translation table finds identifiers of every length")
+{
+    // Identifiers differing only in their last byte, across each block size of the hash
+    linguist::translation_table::builder builder;
+    for (std::size_t length = 1; length <= 130; ++length)
+    {
+        for (const char last : { 'a', 'b' })
+        {
+            builder.add(std::string(length - 1, '.') + last, "en-US", std::to_string(length) + last);
+        }
+    }
+
+    const auto table = builder.build();
+    const auto en = *table.find_locale("en-US");
+    for (std::size_t length = 1; length <= 130; ++length)
+    {
+        for (const char last : { 'a', 'b' })
+        {
+            const auto row = table.find(std::string(length - 1, '.') + last);
+            REQUIRE(row != linguist::translation_table::npos);
+            REQUIRE(table.text(row, en) == std::to_string(length) + last);
+        }
+
+        REQUIRE(table.find(std::string(length - 1, '.') + 'c') == linguist::translation_table::npos);
+    }
+
+    REQUIRE(table.find("") == linguist::translation_table::npos);
+}
+
+TEST_CASE("translation table builds a minimal perfect hash index")
+{
+    linguist::translation_table::builder builder;
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        builder.add("key." + std::to_string(i), "en-US", "Value " + std::to_string(i));
+    }
+
+    const auto table = builder.build(linguist::table_index::perfect_hash);
+    REQUIRE(table.data().index.size() == 1000);
+    REQUIRE(!table.data().displacements.empty());
+
+    const auto en = *table.find_locale("en-US");
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        const auto row = table.find("key." + std::to_string(i));
+        REQUIRE(row != linguist::translation_table::npos);
+        REQUIRE(table.text(row, en) == "Value " + std::to_string(i));
+    }
+
+    REQUIRE(table.find("key.1000") == linguist::translation_table::npos);
+    REQUIRE(table.find("") == linguist::translation_table::npos);
+}
+
+TEST_CASE("translation table builds an empty perfect hash index")
+{
+    const linguist::translation_table::builder builder;
+    const auto table = builder.build(linguist::table_index::perfect_hash);
+    REQUIRE(table.empty());
+    REQUIRE(table.find("any.key") == linguist::translation_table::npos);
+}
+
+/// Memory resource counting the blocks and bytes it hands out
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations{ 0 };
+    std::size_t blocks{ 0 };
+    std::size_t bytes{ 0 };
+
+private:
+    auto do_allocate(std::size_t size, std::size_t alignment) -> void* override
+    {
+        ++allocations;
+        ++blocks;
+        bytes += size;
+        return std::pmr::new_delete_resource()->allocate(size, alignment);
+    }
+
+    void do_deallocate(void* block, std::size_t size, std::size_t alignment) override
+    {
+        --blocks;
+        bytes -= size;
+        std::pmr::new_delete_resource()->deallocate(block, size, alignment);
+    }
+
+    auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+    {
+        return this == &other;
+    }
+};
+
+TEST_CASE("translation table is built into one block of a memory resource")
+{
+    counting_resource staging;
+    counting_resource resource;
+    std::optional<linguist::translation_table> table;
+    {
+        std::pmr::monotonic_buffer_resource scratch(&staging);
+        linguist::translation_table::builder builder(&scratch);
+        for (int32_t i = 0; i < 1000; ++i)
+        {
+            builder.add("key." + std::to_string(i), "en-US", "Value " + std::to_string(i));
+            builder.add("key." + std::to_string(i), "fr-FR", "{count} valeurs");
+        }
+
+        // The staged identifiers take a few large blocks rather than one per identifier
+        REQUIRE(staging.blocks > 0);
+        REQUIRE(staging.blocks < 32);
+
+        table = builder.build(linguist::table_index::perfect_hash, &resource);
+    }
+
+    // The table outlives its builder, and holds its sections and shared state only
+    REQUIRE(staging.blocks == 0);
+    REQUIRE(resource.blocks == 2);
+    REQUIRE(table->memory_usage() > 0);
+    REQUIRE(table->memory_usage() < resource.bytes);
+
+    const auto fr = *table->find_locale("fr-FR");
+    const auto row = table->find("key.999");
+    REQUIRE(table->text(row, *table->find_locale("en-US")) == "Value 999");
+    const auto text = table->text(row, fr);
+    REQUIRE(text == "{count} valeurs");
+    REQUIRE(table->find_message(*text)->ops().size() > 0);
+
+    table.reset();
+    REQUIRE(resource.blocks == 0);
+    REQUIRE(resource.bytes == 0);
+    REQUIRE(resource.allocations == 2);
+}